@@ -0,0 +1,239 @@
+################################################################################
+#
+# (c) 2020 Copyright, Real-Time Innovations, Inc. (RTI)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+################################################################################
+
+################################################################################
+# rmw_connextdds_generate_typecodes(
+#     <target>
+#     IDL_FILES <idl files>
+#     TYPES     <DDS type names>
+#     )
+#
+# Generate the TypeCodes of a set of types with rtiddsgen, and build them
+# into shared library <target>, which registers them with
+# rmw_connextdds_register_typecode() when it is loaded. Processes linking
+# <target> will then use the precomputed TypeCodes instead of generating them
+# at runtime from the types' introspection type support.
+#
+# The IDL files must declare the types with the names used by the RMW
+# (e.g. "std_msgs::msg::dds_::String_", whose members are named like the
+# fields of the ROS 2 message), and TYPES must list the fully-qualified names
+# of the types to register. Types not listed in TYPES (e.g. nested types) are
+# still generated at runtime when needed.
+#
+# Each precomputed TypeCode is compared at build time with the one generated
+# from the type's introspection type support (the packages which define the
+# types must be available to find_package()), and the build fails if they
+# differ. The hash of each type's structure is embedded in <target>, and a
+# precomputed TypeCode is ignored at runtime (with an error) if the type's
+# hash changed since, e.g. because the message package was rebuilt with a
+# different definition.
+################################################################################
+function(rmw_connextdds_generate_typecodes target)
+    cmake_parse_arguments(_rti_tc
+      "" # boolean arguments
+      "" # single value arguments
+      "IDL_FILES;TYPES" # multi-value arguments
+      ${ARGN} # current function arguments
+    )
+
+    # Use the Connext installation that rmw_connextdds_common was built with,
+    # rather than whichever one the calling package might point to.
+    if(NOT TARGET RTIConnextDDS::c_api)
+        set(CONNEXTDDS_DIR "${RMW_CONNEXT_CONNEXTDDS_DIR}")
+        rti_find_connextpro()
+    endif()
+    if(NOT TARGET RTIConnextDDS::c_api)
+        message(FATAL_ERROR
+          "RTI Connext DDS Professional is required to generate type codes")
+    endif()
+
+    set(RTIDDSGEN "${RMW_CONNEXT_RTIDDSGEN}")
+    if("${RTIDDSGEN}" STREQUAL "" OR NOT EXISTS "${RTIDDSGEN}")
+        message(FATAL_ERROR
+          "rtiddsgen not found in ${RMW_CONNEXT_CONNEXTDDS_DIR}/bin")
+    endif()
+
+    set(gen_dir "${CMAKE_CURRENT_BINARY_DIR}/${target}_typecodes")
+    set(gen_sources)
+
+    foreach(idl_file ${_rti_tc_IDL_FILES})
+        get_filename_component(idl_file "${idl_file}" ABSOLUTE)
+        get_filename_component(idl_name "${idl_file}" NAME_WE)
+        set(idl_sources
+            "${gen_dir}/${idl_name}.c"
+            "${gen_dir}/${idl_name}Plugin.c"
+            "${gen_dir}/${idl_name}Support.c")
+        add_custom_command(
+            OUTPUT ${idl_sources}
+            COMMAND ${CMAKE_COMMAND} -E make_directory "${gen_dir}"
+            COMMAND "${RTIDDSGEN}"
+                -language C
+                -replace
+                -unboundedSupport
+                -d "${gen_dir}"
+                "${idl_file}"
+            DEPENDS "${idl_file}"
+            COMMENT "Generating type codes for ${idl_name}.idl"
+            VERBATIM)
+        list(APPEND gen_sources ${idl_sources})
+    endforeach()
+
+    # rtiddsgen generates a "<scoped_name>_get_typecode()" function for each
+    # type, with the scopes of the type's name separated by "_". The type
+    # support of "<pkg>::<subfolder>::dds_::<Name>_" is ROS 2 type
+    # "<pkg>/<subfolder>/<Name>".
+    set(tc_decls)
+    set(ts_decls)
+    set(tc_checks)
+    set(tc_registrations)
+    set(type_packages)
+    set(type_index 0)
+    foreach(type_name ${_rti_tc_TYPES})
+        if(NOT type_name MATCHES "^([^:]+)::([^:]+)::dds_::(.+)_$")
+            message(FATAL_ERROR "unexpected type name: ${type_name}")
+        endif()
+        set(type_pkg "${CMAKE_MATCH_1}")
+        set(ts_symbol
+          "rosidl_typesupport_c__get_message_type_support_handle__")
+        string(APPEND ts_symbol
+          "${CMAKE_MATCH_1}__${CMAKE_MATCH_2}__${CMAKE_MATCH_3}")
+        list(APPEND type_packages "${type_pkg}")
+        string(REPLACE "::" "_" type_symbol "${type_name}")
+        string(APPEND tc_decls
+            "extern \"C\" DDS_TypeCode * ${type_symbol}_get_typecode(void);\n")
+        string(APPEND tc_checks
+            "  ok = check_typecode(\n"
+            "    out, ${type_index}, \"${type_name}\",\n"
+            "    ${ts_symbol}(),\n"
+            "    ${type_symbol}_get_typecode()) && ok;\n")
+        string(APPEND tc_registrations
+            "    rmw_connextdds_register_typecode(\n"
+            "      \"${type_name}\", ${type_symbol}_get_typecode,\n"
+            "      RMW_CONNEXT_TYPE_HASH_${type_index});\n")
+        string(APPEND ts_decls
+            "extern \"C\" const rosidl_message_type_support_t *\n"
+            "${ts_symbol}(void);\n")
+        math(EXPR type_index "${type_index} + 1")
+    endforeach()
+    list(REMOVE_DUPLICATES type_packages)
+
+    # Check the TypeCodes, and record the hashes of the types, at build time
+    set(check_source "${gen_dir}/${target}_check.cpp")
+    file(WRITE "${check_source}.in"
+        "// Generated by rmw_connextdds_generate_typecodes()\n"
+        "#include <cstdio>\n"
+        "\n"
+        "#include \"rmw/error_handling.h\"\n"
+        "\n"
+        "#include \"rmw_connextdds/typecode.hpp\"\n"
+        "\n"
+        "${tc_decls}"
+        "${ts_decls}"
+        "\n"
+        "static bool\n"
+        "check_typecode(\n"
+        "  FILE * const out,\n"
+        "  const int type_index,\n"
+        "  const char * const type_name,\n"
+        "  const rosidl_message_type_support_t * const type_supports,\n"
+        "  const DDS_TypeCode * const tc)\n"
+        "{\n"
+        "  uint64_t type_hash = 0;\n"
+        "  if (RMW_RET_OK !=\n"
+        "    rmw_connextdds_check_typecode(type_supports, type_name, tc, &type_hash))\n"
+        "  {\n"
+        "    std::fprintf(stderr, \"%s\\n\", rmw_get_error_string().str);\n"
+        "    rmw_reset_error();\n"
+        "    return false;\n"
+        "  }\n"
+        "  std::fprintf(\n"
+        "    out, \"#define RMW_CONNEXT_TYPE_HASH_%d 0x%016llxULL\\n\",\n"
+        "    type_index, static_cast<unsigned long long>(type_hash));  // NOLINT\n"
+        "  return true;\n"
+        "}\n"
+        "\n"
+        "int main(int argc, char ** argv)\n"
+        "{\n"
+        "  if (argc != 2) {\n"
+        "    std::fprintf(stderr, \"usage: %s <output file>\\n\", argv[0]);\n"
+        "    return 1;\n"
+        "  }\n"
+        "  FILE * const out = std::fopen(argv[1], \"w\");\n"
+        "  if (nullptr == out) {\n"
+        "    std::fprintf(stderr, \"failed to open %s\\n\", argv[1]);\n"
+        "    return 1;\n"
+        "  }\n"
+        "  bool ok = true;\n"
+        "${tc_checks}"
+        "  std::fclose(out);\n"
+        "  if (!ok) {\n"
+        "    std::remove(argv[1]);\n"
+        "    return 1;\n"
+        "  }\n"
+        "  return 0;\n"
+        "}\n")
+    configure_file("${check_source}.in" "${check_source}" COPYONLY)
+
+    add_executable(${target}_check "${check_source}" ${gen_sources})
+    target_include_directories(${target}_check PRIVATE "${gen_dir}")
+    target_link_libraries(${target}_check
+        rmw_connextdds_common::rmw_connextdds_common_pro
+        RTIConnextDDS::c_api)
+    foreach(type_pkg ${type_packages})
+        find_package(${type_pkg} REQUIRED)
+    endforeach()
+    ament_target_dependencies(${target}_check ${type_packages})
+
+    set(hashes_header "${gen_dir}/${target}_hashes.hpp")
+    add_custom_command(
+        OUTPUT "${hashes_header}"
+        COMMAND ${target}_check "${hashes_header}"
+        DEPENDS ${target}_check
+        COMMENT "Checking type codes of ${target}"
+        VERBATIM)
+
+    set(register_source "${gen_dir}/${target}_register.cpp")
+    file(WRITE "${register_source}.in"
+        "// Generated by rmw_connextdds_generate_typecodes()\n"
+        "#include \"rmw_connextdds/typecode.hpp\"\n"
+        "\n"
+        "#include \"${target}_hashes.hpp\"\n"
+        "\n"
+        "${tc_decls}"
+        "\n"
+        "namespace\n"
+        "{\n"
+        "struct TypeCodeRegistration\n"
+        "{\n"
+        "  TypeCodeRegistration()\n"
+        "  {\n"
+        "${tc_registrations}"
+        "  }\n"
+        "};\n"
+        "\n"
+        "TypeCodeRegistration registration;\n"
+        "}  // namespace\n")
+    configure_file("${register_source}.in" "${register_source}" COPYONLY)
+
+    add_library(${target} SHARED
+        ${gen_sources} "${register_source}" "${hashes_header}")
+    target_include_directories(${target} PRIVATE "${gen_dir}")
+    target_link_libraries(${target}
+        rmw_connextdds_common::rmw_connextdds_common_pro
+        RTIConnextDDS::c_api)
+endfunction()
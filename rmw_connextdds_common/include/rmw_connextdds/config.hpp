@@ -0,0 +1,98 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_CONNEXTDDS__CONFIG_HPP_
+#define RMW_CONNEXTDDS__CONFIG_HPP_
+
+#include <initializer_list>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rmw/ret_types.h"
+
+#include "rmw_connextdds/visibility_control.h"
+
+/******************************************************************************
+ * Helpers to load the RMW's configuration from the environment.
+ * All of them fail with RMW_RET_ERROR (and set the rmw error) if the variable
+ * cannot be looked up, or if it contains an invalid value. Unless noted,
+ * the output argument is left unchanged if the variable is unset or empty.
+ ******************************************************************************/
+
+// Lookup a string (set to "" if the variable is unset).
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_get_env(
+  const char * const name,
+  const char ** const value);
+
+// Lookup a decimal integer, which must be at least `min_value`.
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_get_env_int64(
+  const char * const name,
+  const int64_t min_value,
+  int64_t & value);
+
+// Lookup a flag, which must be either "0" or "1".
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_get_env_bool(
+  const char * const name,
+  bool & value);
+
+// Lookup a value which must be one of `choices`, and return its index.
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_get_env_choice(
+  const char * const name,
+  const std::initializer_list<const char *> choices,
+  size_t & choice);
+
+/* Entry of a configuration table (e.g. the QoS overrides), in the form
+   "<pattern>:<key>=<value>[,<key>=<value>...]". */
+struct RMW_Connext_ConfigEntry
+{
+  std::string pattern;
+  std::vector<std::pair<std::string, std::string>> settings;
+  /* Where the entry was read from, and its text, for error messages */
+  std::string source;
+  std::string text;
+};
+
+// Parse a table of entries separated by `delimiter`, and append them to
+// `entries`. Text following a '#' is ignored, and patterns may contain ':'
+// (e.g. "std_msgs::msg::dds_::*"). Fails if an entry has no
+// pattern, or if one of its settings isn't in the form "<key>=<value>".
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_parse_config_table(
+  const char * const source,
+  std::istream & table,
+  const char delimiter,
+  std::vector<RMW_Connext_ConfigEntry> & entries);
+
+// Lookup a table both from variable `name` (entries separated by ';') and
+// from the file named by variable `file_name` (one entry per line), and
+// append its entries to `entries`, those from the environment first.
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_get_env_table(
+  const char * const name,
+  const char * const file_name,
+  std::vector<RMW_Connext_ConfigEntry> & entries);
+
+#endif  // RMW_CONNEXTDDS__CONFIG_HPP_
@@ -17,12 +17,17 @@
 
 #include <stdio.h>
 
+#include <atomic>
 #include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "rmw_connextdds/dds_api.hpp"
 #include "rmw_connextdds/log.hpp"
+#include "rmw_connextdds/worker_pool.hpp"
 
 #include "rmw/error_handling.h"
 #include "rmw/impl/cpp/macros.hpp"
@@ -56,10 +61,107 @@
 
 extern DDS_DomainParticipantFactory * RMW_Connext_gv_DomainParticipantFactory;
 
+class RMW_Connext_MessageTypeSupport;
+
+/* QoS settings applied to the endpoints of topics whose (DDS) name, or the
+   name of whose type, matches a pattern, configured with
+   RMW_CONNEXT_QOS_OVERRIDES[_FILE]. With Micro, max_samples also sizes the
+   endpoint's preallocated sample pool, and it takes precedence over
+   RMW_CONNEXT_LIMIT_SAMPLES_POOL_SIZE_MAX. */
+struct RMW_Connext_QosOverride
+{
+  enum MatchKind
+  {
+    MATCH_GLOB,
+    /* pattern contains no wildcards */
+    MATCH_EXACT,
+    /* pattern's only wildcard is a trailing '*' */
+    MATCH_PREFIX
+  };
+
+  /* Tuning of the reliability protocol (see
+     rmw_connextdds_get_reliability_preset()) */
+  enum ReliabilityPreset
+  {
+    RELIABILITY_PRESET_DEFAULT,
+    /* small messages, repair losses as soon as possible */
+    RELIABILITY_PRESET_LOW_LATENCY,
+    /* large (fragmented) messages, throttle repairs with a send window */
+    RELIABILITY_PRESET_BULK,
+    /* frequent losses, aggressive heartbeats and small send window */
+    RELIABILITY_PRESET_LOSSY_LINK
+  };
+
+  std::string pattern;
+  MatchKind match_kind{MATCH_GLOB};
+
+  /* Settings (negative if not specified) */
+  int32_t depth{-1};
+  int32_t max_samples{-1};
+  /* Max samples per batch (writers only, 0 to disable batching) */
+  int32_t batch_max_samples{-1};
+  int32_t transport_priority{-1};
+  /* Rate (bytes/s) and burst size (bytes) of the flow controller used by
+     writers. Writers using the same flow controller share its bandwidth. */
+  int32_t flow_rate{-1};
+  int32_t flow_burst{-1};
+  std::string flow_controller;
+
+  bool has_publish_mode{false};
+  bool publish_mode_async{false};
+
+  ReliabilityPreset reliability_preset{RELIABILITY_PRESET_DEFAULT};
+
+  // Select the cheapest matcher for the pattern.
+  void
+  compile();
+
+  bool
+  matches(const char * const topic_name) const;
+};
+
+/* Effective bounds of the unbounded strings and sequences of the types whose
+   (DDS) name matches a pattern, configured with RMW_CONNEXT_TYPE_BOUNDS[_FILE].
+   Types covered by these bounds are handled like bounded types, and samples
+   with a string or sequence longer than them fail to serialize. */
+struct RMW_Connext_TypeBounds
+{
+  std::string pattern;
+  /* Max length of unbounded strings and sequences (negative if not
+     specified) */
+  int32_t max_string{-1};
+  int32_t max_sequence{-1};
+};
+
+/* Type hash advertised by a remote endpoint (see RMW_CONNEXT_TYPE_HASH). */
+struct RMW_Connext_RemoteTypeHash
+{
+  DDS_InstanceHandle_t handle;
+  bool is_reader;
+  uint64_t hash;
+};
+
+/* Policy used by clients to select the server which should handle each
+   request (see RMW_CONNEXT_EMULATE_REQUESTREPLY_TARGET). */
+enum RMW_Connext_ServerSelection
+{
+  /* Send each request to all servers */
+  RMW_CONNEXT_SERVER_SELECTION_ALL,
+  /* Cycle through available servers */
+  RMW_CONNEXT_SERVER_SELECTION_ROUND_ROBIN,
+  /* Select the server with the fewest requests waiting for a reply */
+  RMW_CONNEXT_SERVER_SELECTION_LEAST_OUTSTANDING,
+  /* Keep using the same server for as long as it is available */
+  RMW_CONNEXT_SERVER_SELECTION_AFFINITY
+};
+
 struct rmw_context_impl_t
 {
   rmw_dds_common::Context common;
-  rmw_context_t * base;
+  /* rmw context whose options are used to create the participant. When the
+     implementation is shared, this is reassigned to another attached context
+     whenever the current one is detached. */
+  std::atomic<rmw_context_t *> base;
 
   DDS_DomainParticipantFactory * factory;
 
@@ -68,10 +170,41 @@ struct rmw_context_impl_t
   DDS_DomainId_t domain_id;
   DDS_DomainParticipant * participant;
 
-  /* DDS publisher, subscriber used for ROS 2 publishers and subscriptions */
+  /* DDS publisher, subscriber used for ROS 2 publishers and subscriptions
+     (unless pubsub_per_node is enabled, in which case they are only used for
+     the graph's internal endpoints) */
   DDS_Publisher * dds_pub;
   DDS_Subscriber * dds_sub;
 
+  /* Create a dedicated DDS publisher and subscriber for each node */
+  bool pubsub_per_node{false};
+
+  /* Default max time (in ms) that a reliable writer may block waiting for
+     resources (negative to block indefinitely) */
+  int64_t write_blocking_time_ms{-1};
+
+  /* Default max time (in ms) that a client waits for the reply to a request,
+     after which the reply is discarded (0 to wait indefinitely) */
+  int64_t request_timeout_ms{0};
+
+  /* Default max age (in ms) of the requests taken by a service, after which
+     they are discarded (0 to disable) */
+  int64_t request_max_age_ms{0};
+
+  /* Discard requests whose client is no longer matched by the service */
+  bool discard_departed_requests{false};
+
+  /* QoS overrides for endpoints whose topic or type name matches a pattern,
+     in order of precedence */
+  std::vector<RMW_Connext_QosOverride> qos_overrides;
+
+  /* Effective bounds of types whose name matches a pattern,
+     in order of precedence */
+  std::vector<RMW_Connext_TypeBounds> type_bounds;
+
+  /* Policy used by clients to select a server for each request */
+  RMW_Connext_ServerSelection server_selection{RMW_CONNEXT_SERVER_SELECTION_ALL};
+
   /* Built-in Discovery Readers */
   DDS_DataReader * dr_participants;
   DDS_DataReader * dr_publications;
@@ -85,12 +218,29 @@ struct rmw_context_impl_t
   std::string qos_ctx_name;
   std::string qos_ctx_namespace;
 
+  /* Number of threads used to deserialize batches of taken samples
+     (0 or 1 to disable parallel deserialization) */
+  size_t deserialize_threads{0};
+
+  /* Threads which help subscriptions deserialize batches of taken samples
+     (deserialize_threads - 1 of them, since the taking thread also takes
+     part). Created with the participant, and deleted with it. */
+  std::unique_ptr<RMW_Connext_WorkerPool> deserialize_pool;
+
   /* Participant reference count*/
   size_t node_count{0};
   std::mutex initialization_mutex;
 
-  /* Shutdown flag */
-  bool is_shutdown{false};
+  /* Shutdown flag (set once all attached rmw contexts have been shut down) */
+  std::atomic_bool is_shutdown{false};
+
+  /* Participant sharing (RMW_CONNEXT_PARTICIPANT_SCOPE=process): key of the
+     context in the process-wide pool (empty if the context is not shared),
+     and rmw contexts attached to it, each with its own shutdown flag. The
+     context is removed from the pool once all of them have been shut down.
+     Protected by the pool's mutex. */
+  std::string share_key;
+  std::map<rmw_context_t *, bool> shared_contexts;
 
   /* Keep track of ROS graph subsystem's initialization */
   bool graph_initialized{false};
@@ -99,6 +249,31 @@ struct rmw_context_impl_t
      (protected by initialization_mutex) */
   uint32_t client_service_id{0};
 
+  /* Type supports of the endpoints finalized during a fast teardown, whose
+     DDS entities (which may still use them) are only deleted together with
+     the DomainParticipant (protected by retained_mutex) */
+  std::mutex retained_mutex;
+  std::vector<RMW_Connext_MessageTypeSupport *> retained_type_supports;
+
+  /* Type hashes of local types, and of the remote endpoints for each type
+     name, used to ignore remote endpoints whose type has the same name but
+     a different structure (protected by type_hash_mutex) */
+  std::mutex type_hash_mutex;
+  std::map<std::string, uint64_t> local_type_hashes;
+  std::map<std::string, std::vector<RMW_Connext_RemoteTypeHash>>
+  remote_type_hashes;
+  /* Number of remote endpoints ignored because of their type hash (each
+     node tracks how many of them it has already reported) */
+  uint64_t incompatible_type_count{0};
+
+  // Count a remote endpoint ignored because of its type hash.
+  void
+  incompatible_type_detected()
+  {
+    std::lock_guard<std::mutex> guard(this->type_hash_mutex);
+    this->incompatible_type_count += 1;
+  }
+
   explicit rmw_context_impl_t(rmw_context_t * const base)
   : common(),
     base(base),
@@ -123,6 +298,25 @@ struct rmw_context_impl_t
     common.sub = nullptr;
   }
 
+  // Check whether the specified rmw context, which must be attached to this
+  // implementation, has been shut down.
+  bool
+  is_context_shutdown(rmw_context_t * const context);
+
+  // Whether local entities can be left to be deleted together with the
+  // DomainParticipant (see RMW_CONNEXT_FAST_TEARDOWN).
+  bool
+  fast_teardown() const
+  {
+    return RMW_CONNEXT_FAST_TEARDOWN && this->is_shutdown;
+  }
+
+  // Take ownership of the type support of an endpoint whose DDS entities
+  // were left to be deleted with the DomainParticipant, and delete it after
+  // the DomainParticipant.
+  rmw_ret_t
+  retain_type_support(RMW_Connext_MessageTypeSupport * const type_support);
+
   // Initializes the participant, if it wasn't done already.
   // node_count is increased
   rmw_ret_t
@@ -154,6 +348,20 @@ struct rmw_context_impl_t
     DDS_Topic ** const topic,
     bool & created);
 
+  // Create a new (disabled) pair of DDS publisher and subscriber
+  // in the context's DomainParticipant.
+  rmw_ret_t
+  create_pubsub(
+    DDS_Publisher ** const pub_out,
+    DDS_Subscriber ** const sub_out);
+
+  // Delete a DDS publisher and subscriber, and any remaining
+  // entity contained in them.
+  rmw_ret_t
+  delete_pubsub(
+    DDS_Publisher * const pub,
+    DDS_Subscriber * const sub);
+
   rmw_ret_t
   clean_up(const bool finalize_factory = true);
 };
@@ -135,19 +135,61 @@ DDS_DataReader *
   DDS_TopicDescription * const topic_desc,
   DDS_DataReaderQos * const dr_qos);
 
+// Write a message, and store the sequence number assigned to it by the
+// writer in sn_out (if not null, and if the DDS API reports it).
 rmw_ret_t
 rmw_connextdds_write_message(
   RMW_Connext_Publisher * const pub,
   RMW_Connext_Message * const message,
   int64_t * const sn_out);
 
+rmw_ret_t
+rmw_connextdds_set_flow_rate(
+  RMW_Connext_Publisher * const pub,
+  const uint64_t rate,
+  const uint64_t burst);
+
+// Block (up to max_wait) until the sample with sequence number sn, written
+// by a reliable reply writer, has been acknowledged by the reply reader of
+// a client. Returns immediately, with matched set to false, if the reader
+// is not matched.
+rmw_ret_t
+rmw_connextdds_wait_for_reply_acknowledgment(
+  RMW_Connext_Publisher * const pub,
+  const rmw_gid_t & reader,
+  const int64_t sn,
+  const DDS_Duration_t * const max_wait,
+  bool & matched);
+
+// Advertise the GUID of the local endpoint paired with a writer (e.g. the
+// request reader of a service, for its reply writer) in the writer's
+// discovery data. Must be called before the writer is enabled.
+rmw_ret_t
+rmw_connextdds_set_paired_endpoint(
+  RMW_Connext_Publisher * const pub,
+  const rmw_gid_t & paired);
+
+// Look up the endpoint advertised as paired with a writer matched by sub.
+// found is set to false if the writer is not matched, or if it didn't
+// advertise any paired endpoint.
+rmw_ret_t
+rmw_connextdds_get_paired_endpoint(
+  RMW_Connext_Subscriber * const sub,
+  const rmw_gid_t & writer,
+  rmw_gid_t & paired,
+  bool & found);
+
 rmw_ret_t
 rmw_connextdds_take_samples(
-  RMW_Connext_Subscriber * const sub);
+  RMW_Connext_Subscriber * const sub,
+  RMW_Connext_UntypedSampleSeq * const data_seq,
+  DDS_SampleInfoSeq * const info_seq);
 
 rmw_ret_t
 rmw_connextdds_return_samples(
-  RMW_Connext_Subscriber * const sub);
+  RMW_Connext_Subscriber * const sub,
+  RMW_Connext_UntypedSampleSeq * const data_seq,
+  DDS_SampleInfoSeq * const info_seq);
 
 rmw_ret_t
 rmw_connextdds_filter_sample(
@@ -168,11 +210,19 @@ rmw_connextdds_register_type_support(
   const bool intro_members_cpp,
   const char * const type_name);
 
+// Record the hash of a local type, and ignore the remote endpoints which
+// advertised a different hash for a type with the same name.
+rmw_ret_t
+rmw_connextdds_assert_type_hash(
+  rmw_context_impl_t * const ctx,
+  RMW_Connext_MessageTypeSupport * const type_support);
+
 rmw_ret_t
 rmw_connextdds_unregister_type_support(
   rmw_context_impl_t * const ctx,
   DDS_DomainParticipant * const participant,
-  const char * const type_name);
+  const char * const type_name,
+  const bool keep_registered);
 
 rmw_ret_t
 rmw_connextdds_dcps_participant_get_reader(
@@ -35,6 +35,10 @@
 #define RMW_CONNEXT_LIMIT_WRITERS_LOCAL_MAX             RMW_CONNEXT_LIMIT_DEFAULT_MAX
 #endif /* RMW_CONNEXT_LIMIT_WRITERS_LOCAL_MAX */
 
+#ifndef RMW_CONNEXT_LIMIT_NODES_LOCAL_MAX
+#define RMW_CONNEXT_LIMIT_NODES_LOCAL_MAX               RMW_CONNEXT_LIMIT_DEFAULT_MAX
+#endif /* RMW_CONNEXT_LIMIT_NODES_LOCAL_MAX */
+
 #ifndef RMW_CONNEXT_LIMIT_PARTICIPANTS_REMOTE_MAX
 #define RMW_CONNEXT_LIMIT_PARTICIPANTS_REMOTE_MAX       RMW_CONNEXT_LIMIT_DEFAULT_MAX
 #endif /* RMW_CONNEXT_LIMIT_PARTICIPANTS_REMOTE_MAX */
@@ -47,12 +51,55 @@
 #define RMW_CONNEXT_LIMIT_READERS_REMOTE_MAX            RMW_CONNEXT_LIMIT_DEFAULT_MAX
 #endif /* RMW_CONNEXT_LIMIT_READERS_REMOTE_MAX */
 
+/* Max number of matches between local readers and remote writers, and
+   between local writers and remote readers. If 0, the number of matches is
+   bounded by the product of the number of local and remote endpoints. */
+#ifndef RMW_CONNEXT_LIMIT_MATCHES_MAX
+#define RMW_CONNEXT_LIMIT_MATCHES_MAX                   0
+#endif /* RMW_CONNEXT_LIMIT_MATCHES_MAX */
+
 #ifndef RMW_CONNEXT_LIMIT_SAMPLES_MAX
 #define RMW_CONNEXT_LIMIT_SAMPLES_MAX                   10
 #endif /* RMW_CONNEXT_LIMIT_SAMPLES_MAX */
 
+/* Max size (in bytes) of the sample pool preallocated by each endpoint of a
+   bounded type (Micro only). The number of samples allocated by an endpoint
+   is reduced to fit the pool, but never below its history depth. If 0, all
+   endpoints allocate at least RMW_CONNEXT_LIMIT_SAMPLES_MAX samples. */
+#ifndef RMW_CONNEXT_LIMIT_SAMPLES_POOL_SIZE_MAX
+#define RMW_CONNEXT_LIMIT_SAMPLES_POOL_SIZE_MAX         0
+#endif /* RMW_CONNEXT_LIMIT_SAMPLES_POOL_SIZE_MAX */
+
 #ifndef RMW_CONNEXT_LIMIT_KEEP_ALL_SAMPLES
 #define RMW_CONNEXT_LIMIT_KEEP_ALL_SAMPLES              1000
 #endif /* RMW_CONNEXT_LIMIT_SAMPLES_MAX */
 
+/* Max number of loans that each subscription may hold on its DDS reader's
+   samples at the same time. */
+#ifndef RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX
+#define RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX         2
+#endif /* RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX */
+
+/* Max number of requests that each client keeps track of while waiting for
+   their replies. If exceeded, the oldest request is considered timed out
+   (even if the client has no request timeout), and its reply is ignored. */
+#ifndef RMW_CONNEXT_LIMIT_PENDING_REQUESTS_MAX
+#define RMW_CONNEXT_LIMIT_PENDING_REQUESTS_MAX          1024
+#endif /* RMW_CONNEXT_LIMIT_PENDING_REQUESTS_MAX */
+
+/* Max number of parts of a streamed reply which may be written by a service
+   before they are acknowledged by the reply reader of its client (further
+   parts are only written once the oldest ones have been acknowledged).
+   Each stream has its own window, so a slow client doesn't delay the
+   replies sent to other clients. */
+#ifndef RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW
+#define RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW           8
+#endif /* RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW */
+
+/* Max number of demangled topic and type names cached (the cache is cleared
+   once it is full). */
+#ifndef RMW_CONNEXT_LIMIT_DEMANGLE_CACHE_MAX
+#define RMW_CONNEXT_LIMIT_DEMANGLE_CACHE_MAX            1024
+#endif /* RMW_CONNEXT_LIMIT_DEMANGLE_CACHE_MAX */
+
 #endif  // RMW_CONNEXTDDS__RESOURCE_LIMITS_HPP_
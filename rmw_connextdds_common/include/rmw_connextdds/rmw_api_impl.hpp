@@ -126,6 +126,18 @@ rmw_api_connextdds_service_server_is_available(
   const rmw_client_t * client,
   bool * is_available);
 
+/* Get the GIDs of the servers that a client can currently exchange requests
+   and replies with (i.e. which are matched in both directions). Up to
+   servers_len GIDs are stored in servers (which may be NULL if servers_len
+   is 0), and servers_count is set to the total number of servers. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_client_get_available_servers(
+  const rmw_client_t * client,
+  rmw_gid_t * servers,
+  const size_t servers_len,
+  size_t * servers_count);
+
 RMW_CONNEXTDDS_PUBLIC
 rmw_ret_t
 rmw_api_connextdds_count_publishers(
@@ -236,6 +248,28 @@ rmw_ret_t
 rmw_api_connextdds_node_assert_liveliness(const rmw_node_t * node);
 #endif /* RMW_CONNEXT_RELEASE <= RMW_CONNEXT_RELEASE_ELOQUENT */
 
+/* Status of the remote endpoints ignored by a node's participant because
+   they advertised a type with the same name as a local type, but with a
+   different structure (see RMW_CONNEXT_TYPE_HASH). Endpoints are ignored by
+   the participant, so the status covers all the nodes which share it. */
+struct rmw_connextdds_incompatible_type_status_t
+{
+  /* Number of remote endpoints ignored by the participant */
+  uint64_t total_count;
+  /* Number of remote endpoints ignored since the node last read the status */
+  uint64_t total_count_change;
+};
+
+/* Read (and reset the node's "change" counter of) the status of the remote
+   endpoints ignored because of an incompatible type. Each node has its own
+   "change" counter, so reading the status from one node doesn't affect the
+   others. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_node_get_incompatible_type_status(
+  const rmw_node_t * rmw_node,
+  rmw_connextdds_incompatible_type_status_t * status);
+
 /*****************************************************************************
  * Publication API
  *****************************************************************************/
@@ -338,6 +372,54 @@ rmw_api_connextdds_destroy_publisher(
   rmw_node_t * node,
   rmw_publisher_t * publisher);
 
+/* Publisher options specific to this RMW, which may be passed to
+   rmw_create_publisher() via rmw_publisher_options_t's
+   rmw_specific_publisher_payload. */
+struct rmw_connextdds_publisher_options_t
+{
+  /* Max time that a reliable publisher may block in rmw_publish() waiting
+     for resources (e.g. when the send window of a KEEP_ALL publisher is full)
+     before failing (see rmw_api_connextdds_publisher_get_write_timeouts()).
+     A zero value selects the default, configured via
+     RMW_CONNEXT_WRITE_BLOCKING_TIME (infinite if unset). */
+  rmw_time_t max_blocking_time;
+  /* Never block in rmw_publish(), and fail immediately if a message cannot
+     be queued (overrides max_blocking_time). */
+  bool try_publish;
+  /* Transport priority of the publisher's messages. A zero value selects the
+     default, possibly configured via RMW_CONNEXT_QOS_OVERRIDES. With
+     Connext Professional, it is mapped to the IP TOS byte (i.e. DSCP << 2)
+     of UDPv4 packets. */
+  int32_t transport_priority;
+  /* Max rate (in bytes/s) at which the publisher sends data, and size of the
+     bursts (in bytes) that may exceed it (zero to use the default, possibly
+     configured via RMW_CONNEXT_QOS_OVERRIDES). Only supported by Connext
+     Professional, using a flow controller shared by the topic's publishers:
+     creating a publisher fails if the controller already exists with a
+     different rate or burst size. */
+  uint64_t flow_rate;
+  uint64_t flow_burst;
+};
+
+/* Number of times that publishing a message failed because the publisher's
+   max blocking time expired. Unless RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT is
+   enabled, these failures are reported with RMW_RET_ERROR. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_publisher_get_write_timeouts(
+  const rmw_publisher_t * publisher,
+  uint64_t * timeouts);
+
+/* Change the rate (in bytes/s, zero for unlimited) and burst size (in bytes,
+   zero for the default) of the flow controller used by a publisher. This
+   affects all publishers which share the same flow controller. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_publisher_set_flow_rate(
+  const rmw_publisher_t * publisher,
+  uint64_t rate,
+  uint64_t burst);
+
 /*****************************************************************************
  * Serialization API
  *****************************************************************************/
@@ -434,6 +516,122 @@ rmw_ret_t
 rmw_api_connextdds_destroy_service(
   rmw_node_t * node,
   rmw_service_t * service);
+
+/* Status of the requests sent by a client that didn't receive a reply before
+   their timeout expired (see rmw_api_connextdds_client_set_request_timeout()),
+   or that were dropped to make room for newer ones once the client had
+   RMW_CONNEXT_LIMIT_PENDING_REQUESTS_MAX pending requests.
+   Replies to these requests are discarded without being deserialized. */
+struct rmw_connextdds_request_timeout_status_t
+{
+  /* Total number of requests that timed out */
+  uint64_t total_count;
+  /* Number of requests that timed out since the status was last read */
+  uint64_t total_count_change;
+  /* Sequence number of the last request that timed out (0 if none) */
+  int64_t last_sequence_number;
+};
+
+/* Set the max time (in ms, 0 to wait indefinitely) that a client waits for
+   the reply to the requests that it sends afterwards. The default value may
+   be set with environment variable RMW_CONNEXT_REQUEST_TIMEOUT. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_client_set_request_timeout(
+  const rmw_client_t * client,
+  const int64_t timeout_ms);
+
+/* Read (and reset the "change" counters of) the status of the client's
+   timed out requests. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_client_get_request_timeout_status(
+  const rmw_client_t * client,
+  rmw_connextdds_request_timeout_status_t * status);
+
+/* Get the number of requests sent by a client that are still waiting for a
+   reply. When the client selects a server for each request (see
+   RMW_CONNEXT_SERVER_SELECTION), the requests sent to a server which is no
+   longer available are dropped the next time that a request is sent. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_client_get_pending_requests_count(
+  const rmw_client_t * client,
+  size_t * count);
+
+/* Set the priority of the requests that a client sends afterwards (0 by
+   default). Services take requests with higher priority first. Only
+   available if RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY is enabled. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_client_set_request_priority(
+  const rmw_client_t * client,
+  const int32_t priority);
+
+/* Send a part of a response, which is streamed to the client as an ordered
+   sequence of parts (the last one with last=true). If the reply writer is
+   reliable, each part is only written once enough of the previous parts of
+   the same response have been acknowledged by the client (see
+   RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW), blocking up to the writer's max
+   blocking time (RMW_RET_TIMEOUT is returned if the part could not be
+   written). The parts of a response must be sent by one thread at a time. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_send_response_part(
+  const rmw_service_t * service,
+  rmw_request_id_t * request_id,
+  void * ros_response,
+  const bool last);
+
+/* Take the next response (or part of a streamed response) received by a
+   client. Flag last is set to false if more parts of the same response will
+   follow. Parts of a response are taken in the order in which they were
+   sent. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_take_response_part(
+  const rmw_client_t * client,
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  rmw_service_info_t * request_header,
+#else
+  rmw_request_id_t * request_header,
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+  void * ros_response,
+  bool * last,
+  bool * taken);
+
+/* Status of the requests discarded by a service before they were taken
+   (and deserialized), because they were stale (see
+   rmw_api_connextdds_service_set_request_discard()). */
+struct rmw_connextdds_request_discard_status_t
+{
+  /* Number of requests whose client was no longer matched */
+  uint64_t departed_count;
+  /* Number of requests older than the service's max age */
+  uint64_t expired_count;
+  /* Number of requests discarded since the status was last read */
+  uint64_t total_count_change;
+};
+
+/* Configure a service to discard the requests that it hasn't taken yet when
+   their client is no longer matched (e.g. because its participant left the
+   graph), or when their source timestamp is older than max_age_ms (0 to
+   disable). The default values may be set with environment variables
+   RMW_CONNEXT_DISCARD_DEPARTED_REQUESTS and RMW_CONNEXT_REQUEST_MAX_AGE. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_service_set_request_discard(
+  const rmw_service_t * service,
+  const bool discard_departed,
+  const int64_t max_age_ms);
+
+/* Read (and reset the "change" counter of) the status of the requests
+   discarded by a service. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_service_get_request_discard_status(
+  const rmw_service_t * service,
+  rmw_connextdds_request_discard_status_t * status);
 /*****************************************************************************
  * Subscription API
  *****************************************************************************/
@@ -560,6 +758,27 @@ rmw_api_connextdds_return_loaned_message_from_subscription(
   const rmw_subscription_t * subscription,
   void * loaned_message);
 
+/* Fields of rmw_message_info_t populated by the take functions. Fields which
+   are not selected are left untouched in the output rmw_message_info_t. */
+enum RMW_Connext_MessageInfoField
+{
+  RMW_CONNEXT_MESSAGE_INFO_NONE = 0,
+  RMW_CONNEXT_MESSAGE_INFO_PUBLISHER_GID = 1 << 0,
+  RMW_CONNEXT_MESSAGE_INFO_TIMESTAMPS = 1 << 1,
+  RMW_CONNEXT_MESSAGE_INFO_ALL =
+    RMW_CONNEXT_MESSAGE_INFO_PUBLISHER_GID |
+    RMW_CONNEXT_MESSAGE_INFO_TIMESTAMPS
+};
+
+/* Select which fields of rmw_message_info_t will be populated by
+   subsequent rmw_take_*_with_info() calls on a subscription
+   (default: RMW_CONNEXT_MESSAGE_INFO_ALL). */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_api_connextdds_subscription_set_message_info_fields(
+  const rmw_subscription_t * subscription,
+  const uint32_t fields);
+
 /*****************************************************************************
  * WaitSet API
  *****************************************************************************/
@@ -21,6 +21,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <deque>
+#include <list>
 
 #include "rmw_connextdds/context.hpp"
 #include "rmw_connextdds/type_support.hpp"
@@ -28,6 +30,7 @@
 #include "rmw_connextdds/namespace_prefix.hpp"
 #include "rmw_connextdds/rmw_api_impl.hpp"
 
+#include "rcutils/time.h"
 #include "rcutils/types/uint8_array.h"
 #include "rcpputils/thread_safety_annotations.hpp"
 
@@ -573,9 +576,17 @@ class RMW_Connext_SubscriberStatusCondition : public RMW_Connext_StatusCondition
 public:
   RMW_Connext_SubscriberStatusCondition(
     DDS_DataReader * const reader,
-    const bool ignore_local)
+    const bool ignore_local,
+    const int64_t lifespan_ns = 0,
+    const DDS_GUID_t * const related_writer_filter = nullptr,
+    const bool filter_request_target = false)
   : RMW_Connext_StatusCondition(DDS_DataReader_as_entity(reader)),
     ignore_local(ignore_local),
+    lifespan_ns(lifespan_ns),
+    samples_expired(0),
+    samples_expired_change(0),
+    filter_related_writer(nullptr != related_writer_filter),
+    filter_request_target(filter_request_target),
     participant_handle(
       DDS_Entity_get_instance_handle(
         DDS_DomainParticipant_as_entity(
@@ -585,6 +596,10 @@ public:
     dcond(nullptr),
     attached_waitset_dcond(nullptr)
   {
+    if (this->filter_related_writer) {
+      this->related_writer_guid = *related_writer_filter;
+    }
+
     this->dcond = DDS_GuardCondition_new();
     if (nullptr == this->dcond) {
       RMW_CONNEXT_LOG_ERROR_SET("failed to create reader's data condition")
@@ -649,6 +664,13 @@ public:
     return RMW_RET_OK;
   }
 
+  void
+  expire_sample()
+  {
+    this->samples_expired += 1;
+    this->samples_expired_change += 1;
+  }
+
   rmw_ret_t
   set_data_available(const bool available)
   {
@@ -662,6 +684,24 @@ public:
   }
 
   const bool ignore_local;
+  /* Max age of received samples, used to emulate DDS_LifespanQosPolicy on
+     the reader side when the DDS implementation doesn't support it
+     (0 if disabled) */
+  const int64_t lifespan_ns;
+  /* Number of samples dropped because older than lifespan_ns, and of those
+     not yet reported as lost samples (updated by DDS' receive threads, see
+     expire_sample()) */
+  std::atomic<uint64_t> samples_expired;
+  std::atomic<uint64_t> samples_expired_change;
+  /* Emulated content filter, which only accepts replies to requests sent
+     by related_writer_guid (see rmw_connextdds_parse_related_writer_filter) */
+  const bool filter_related_writer;
+  DDS_GUID_t related_writer_guid;
+  /* Drop requests targeted to other servers, i.e. whose request header
+     doesn't contain request_target_gid (see
+     RMW_CONNEXT_EMULATE_REQUESTREPLY_TARGET) */
+  const bool filter_request_target;
+  rmw_gid_t request_target_gid;
   const DDS_InstanceHandle_t participant_handle;
 
 protected:
@@ -679,9 +719,18 @@ protected:
 class RMW_Connext_Node
 {
   rmw_context_impl_t * ctx;
+  /* DDS publisher/subscriber owned by the node (if any) */
+  DDS_Publisher * dds_pub;
+  DDS_Subscriber * dds_sub;
+  /* Context's count of ignored remote endpoints when the node last read its
+     incompatible type status (protected by the context's type_hash_mutex) */
+  uint64_t incompatible_type_count_read;
 
   explicit RMW_Connext_Node(rmw_context_impl_t * const ctx)
-  : ctx(ctx)
+  : ctx(ctx),
+    dds_pub(nullptr),
+    dds_sub(nullptr),
+    incompatible_type_count_read(0)
   {}
 
 public:
@@ -697,6 +746,31 @@ public:
   {
     return this->ctx->common.graph_guard_condition;
   }
+
+  DDS_Publisher *
+  dds_publisher() const
+  {
+    return (nullptr != this->dds_pub) ? this->dds_pub : this->ctx->dds_pub;
+  }
+
+  DDS_Subscriber *
+  dds_subscriber() const
+  {
+    return (nullptr != this->dds_sub) ? this->dds_sub : this->ctx->dds_sub;
+  }
+
+  // Read the status of the remote endpoints ignored by the context's
+  // participant because of their type. The "change" counter is tracked
+  // separately by each node.
+  void
+  incompatible_type_status(rmw_connextdds_incompatible_type_status_t & status)
+  {
+    std::lock_guard<std::mutex> guard(this->ctx->type_hash_mutex);
+    status.total_count = this->ctx->incompatible_type_count;
+    status.total_count_change =
+      status.total_count - this->incompatible_type_count_read;
+    this->incompatible_type_count_read = status.total_count;
+  }
 };
 
 
@@ -789,6 +863,10 @@ public:
   size_t
   subscriptions_count();
 
+  // GIDs of the currently matched DataReaders.
+  rmw_ret_t
+  matched_subscriptions(std::vector<rmw_gid_t> & gids);
+
   rmw_ret_t
   assert_liveliness();
 
@@ -818,6 +896,12 @@ public:
     return DDS_Publisher_get_participant(pub);
   }
 
+  uint64_t
+  write_timeouts() const
+  {
+    return this->write_timeouts_count.load();
+  }
+
 private:
   rmw_context_impl_t * ctx;
   DDS_DataWriter * dds_writer;
@@ -825,6 +909,7 @@ private:
   const bool created_topic;
   rmw_gid_t ros_gid;
   RMW_Connext_PublisherStatusCondition status_condition;
+  std::atomic<uint64_t> write_timeouts_count;
 
   RMW_Connext_Publisher(
     rmw_context_impl_t * const ctx,
@@ -857,6 +942,32 @@ rmw_connextdds_destroy_publisher(
  * Subscription support
  ******************************************************************************/
 
+/* Samples loaned from a DDS reader, and position of the next one which
+   should be consumed. */
+struct RMW_Connext_SubscriberLoan
+{
+  RMW_Connext_UntypedSampleSeq data;
+  DDS_SampleInfoSeq info;
+  size_t len;
+  size_t next;
+  /* Order in which samples are consumed (empty for the order in which
+     they were taken) */
+  std::vector<size_t> order;
+
+  bool
+  consumed() const
+  {
+    return this->next >= this->len;
+  }
+
+  // Position (in data and info) of the next sample to consume.
+  size_t
+  next_index() const
+  {
+    return this->order.empty() ? this->next : this->order[this->next];
+  }
+};
+
 class RMW_Connext_Subscriber
 {
 public:
@@ -891,17 +1002,6 @@ public:
     return this->dds_reader;
   }
 
-  RMW_Connext_UntypedSampleSeq *
-  data_seq()
-  {
-    return &this->loan_data;
-  }
-  DDS_SampleInfoSeq *
-  info_seq()
-  {
-    return &this->loan_info;
-  }
-
   RMW_Connext_MessageTypeSupport *
   message_type_support() const
   {
@@ -958,6 +1058,10 @@ public:
   size_t
   publications_count();
 
+  // GIDs of the currently matched DataWriters.
+  rmw_ret_t
+  matched_publications(std::vector<rmw_gid_t> & gids);
+
   rmw_ret_t
   qos(rmw_qos_profile_t * const qos);
 
@@ -968,21 +1072,51 @@ public:
   return_messages();
 
   rmw_ret_t
-  loan_messages_if_needed()
+  return_consumed_messages()
+  {
+    while (this->loan_count > 0 && this->loans[this->loan_head].consumed()) {
+      rmw_ret_t rc = this->return_messages();
+      if (RMW_RET_OK != rc) {
+        return rc;
+      }
+    }
+    return RMW_RET_OK;
+  }
+
+  // Oldest loan which still contains samples that haven't been consumed.
+  RMW_Connext_SubscriberLoan *
+  active_loan()
+  {
+    for (size_t i = 0; i < this->loan_count; i++) {
+      RMW_Connext_SubscriberLoan * const loan =
+        &this->loans[(this->loan_head + i) %
+        RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX];
+      if (!loan->consumed()) {
+        return loan;
+      }
+    }
+    return nullptr;
+  }
+
+  rmw_ret_t
+  loan_messages_if_needed(const bool retain_consumed = false)
   {
     rmw_ret_t rc = RMW_RET_OK;
 
-    // take messages from reader if we don't have an outstanding loan
-    // or if we have consumed the current loan
-    if (this->loan_len == 0 || this->loan_next >= this->loan_len) {
-      /* return any previously loaned messages */
-      if (this->loan_len > 0) {
-        rc = this->return_messages();
-        if (RMW_RET_OK != rc) {
-          return rc;
-        }
+    /* return any consumed loan, unless the caller still references
+       some of its samples */
+    if (!retain_consumed) {
+      rc = this->return_consumed_messages();
+      if (RMW_RET_OK != rc) {
+        return rc;
       }
-      /* loan messages from reader */
+    }
+
+    // take messages from reader if we have consumed all outstanding loans
+    // and the reader allows for another one
+    if (nullptr == this->active_loan() &&
+      this->loan_count < RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX)
+    {
       rc = this->loan_messages();
       if (RMW_RET_OK != rc) {
         return rc;
@@ -1005,14 +1139,18 @@ public:
     const size_t max_samples,
     size_t * const taken,
     const bool serialized,
-    const DDS_InstanceHandle_t * const request_writer_handle = nullptr);
+    const DDS_InstanceHandle_t * const request_writer_handle = nullptr,
+    RMW_Connext_Client * const reply_client = nullptr,
+    RMW_Connext_Service * const request_service = nullptr);
 
   rmw_ret_t
   take_message(
     void * const ros_message,
     rmw_message_info_t * const message_info,
     bool * const taken,
-    const DDS_InstanceHandle_t * const request_writer_handle = nullptr);
+    const DDS_InstanceHandle_t * const request_writer_handle = nullptr,
+    RMW_Connext_Client * const reply_client = nullptr,
+    RMW_Connext_Service * const request_service = nullptr);
 
 #if RMW_CONNEXT_HAVE_TAKE_SEQ
   rmw_ret_t
@@ -1029,6 +1167,13 @@ public:
     rmw_message_info_t * const message_info,
     bool * const taken);
 
+  void
+  message_info_fields(const uint32_t fields)
+  {
+    std::lock_guard<std::mutex> lock(this->loan_mutex);
+    this->info_fields = fields;
+  }
+
   bool
   has_data()
   {
@@ -1037,9 +1182,7 @@ public:
       RMW_CONNEXT_LOG_ERROR("failed to check loaned messages")
       return false;
     }
-    bool has_data = this->loan_len > 0;
-    RMW_CONNEXT_ASSERT(!has_data || this->loan_next < this->loan_len)
-    return has_data;
+    return nullptr != this->active_loan();
   }
 
   DDS_Subscriber * dds_subscriber()
@@ -1070,11 +1213,16 @@ private:
   rmw_gid_t ros_gid;
   const bool created_topic;
   RMW_Connext_SubscriberStatusCondition status_condition;
-  RMW_Connext_UntypedSampleSeq loan_data;
-  DDS_SampleInfoSeq loan_info;
-  size_t loan_len;
-  size_t loan_next;
+  /* Outstanding loans, consumed (and returned) in the order in which they
+     were taken, starting from loans[loan_head] */
+  RMW_Connext_SubscriberLoan loans[RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX];
+  size_t loan_head;
+  size_t loan_count;
   std::mutex loan_mutex;
+  uint32_t info_fields;
+  /* Consume loaned requests in order of priority
+     (see RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY) */
+  bool order_by_priority;
 
   RMW_Connext_Subscriber(
     rmw_context_impl_t * const ctx,
@@ -1084,7 +1232,9 @@ private:
     const bool ignore_local,
     const bool created_topic,
     DDS_TopicDescription * const dds_topic_cft,
-    const bool internal);
+    const bool internal,
+    const int64_t lifespan_ns,
+    const DDS_GUID_t * const related_writer_filter);
 
   // friend class RMW_Connext_SubscriberStatusCondition;
 };
@@ -1113,29 +1263,89 @@ rmw_connextdds_destroy_subscriber(
 void
 rmw_connextdds_message_info_from_dds(
   rmw_message_info_t * const to,
-  const DDS_SampleInfo * const from);
+  const DDS_SampleInfo * const from,
+  const uint32_t fields = RMW_CONNEXT_MESSAGE_INFO_ALL);
 
 /******************************************************************************
  * Client/Service support
  ******************************************************************************/
 
+/* Endpoints of a server matched by a client in both directions */
+struct RMW_Connext_ServerEndpoints
+{
+  rmw_gid_t request_reader;
+  rmw_gid_t reply_writer;
+};
+
 class RMW_Connext_Client
 {
+  /* A request waiting for a reply */
+  struct PendingRequest
+  {
+    /* Deadline of the request (0 if it never times out) */
+    rcutils_time_point_value_t deadline;
+    /* Reply writer of the server selected for the request (all zeros if
+       any server may reply) */
+    rmw_gid_t server;
+  };
+
   RMW_Connext_Publisher * request_pub;
   RMW_Connext_Subscriber * reply_sub;
-#if RMW_CONNEXT_EMULATE_REQUESTREPLY
-  std::atomic_uint next_request_id;
-#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
+  /* Sequence numbers are assigned by the client, so that requests may be
+     tracked before they are written */
+  std::atomic<int64_t> next_request_id;
+  /* Requests waiting for a reply, indexed by sequence number. The state
+     used to select servers is also protected by pending_mutex, since the
+     load of a server is the number of its pending requests. */
+  std::mutex pending_mutex;
+  std::map<int64_t, PendingRequest> pending_requests;
+  int64_t request_timeout_ms;
+  rmw_connextdds_request_timeout_status_t timeout_status;
+  std::atomic<int32_t> request_priority;
+  RMW_Connext_ServerSelection server_selection;
+  size_t selection_next;
+  bool selection_has_affinity;
+  rmw_gid_t selection_affinity;
 
   RMW_Connext_Client()
   : request_pub(nullptr),
-    reply_sub(nullptr)
-#if RMW_CONNEXT_EMULATE_REQUESTREPLY
-    ,
-    next_request_id(1)
-#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
+    reply_sub(nullptr),
+    next_request_id(1),
+    request_timeout_ms(0),
+    timeout_status{0, 0, 0},
+    request_priority(0),
+    server_selection(RMW_CONNEXT_SERVER_SELECTION_ALL),
+    selection_next(0),
+    selection_has_affinity(false)
   {}
 
+  // Select the server which should handle the next request among the
+  // available ones, according to server_selection (target and server are
+  // set to all zeros to select any server). Must be called with
+  // pending_mutex held.
+  void
+  select_server(
+    const std::vector<RMW_Connext_ServerEndpoints> & servers,
+    rmw_gid_t & target,
+    rmw_gid_t & server);
+
+  // Drop the pending requests sent to servers which are no longer available
+  // (they will never be replied), so that they don't count towards the load
+  // of any server. Must be called with pending_mutex held.
+  void
+  drop_departed_requests(
+    const std::vector<RMW_Connext_ServerEndpoints> & servers);
+
+  // Number of pending requests sent to the server with the given reply
+  // writer. Must be called with pending_mutex held.
+  size_t
+  server_load(const rmw_gid_t & reply_writer);
+
+  // Drop the pending requests whose deadline has expired (or the oldest one,
+  // to make room for a new request). Must be called with pending_mutex held.
+  void
+  expire_requests(const bool make_room);
+
 public:
   static
   RMW_Connext_Client *
@@ -1154,11 +1364,45 @@ public:
   rmw_ret_t
   is_service_available(bool & available);
 
+  // Endpoints of the servers which are matched by both the request writer
+  // and the reply reader.
+  rmw_ret_t
+  available_servers(std::vector<RMW_Connext_ServerEndpoints> & servers);
+
+  // Take the next reply (or part of a streamed reply, in which case last
+  // is set to false if more parts will follow).
   rmw_ret_t
   take_response(
     rmw_service_info_t * const request_header,
     void * const ros_response,
-    bool * const taken);
+    bool * const taken,
+    bool * const last = nullptr);
+
+  // Check whether a reply (before it is deserialized) is related to a
+  // pending request, and stop tracking that request.
+  bool
+  accept_reply(
+    const rcutils_uint8_array_t * const data_buffer,
+    const DDS_SampleInfo * const info);
+
+  void
+  set_request_timeout(const int64_t timeout_ms)
+  {
+    std::lock_guard<std::mutex> guard(this->pending_mutex);
+    this->request_timeout_ms = timeout_ms;
+  }
+
+  void
+  request_timeout_status(rmw_connextdds_request_timeout_status_t & status);
+
+  size_t
+  pending_requests_count();
+
+  void
+  set_request_priority(const int32_t priority)
+  {
+    this->request_priority = priority;
+  }
 
   rmw_ret_t
   send_request(
@@ -1185,6 +1429,64 @@ class RMW_Connext_Service
 {
   RMW_Connext_Publisher * reply_pub;
   RMW_Connext_Subscriber * request_sub;
+  /* Discard stale requests before they are taken (see accept_request()) */
+  std::mutex discard_mutex;
+  bool discard_departed;
+  int64_t request_max_age_ms;
+  rmw_connextdds_request_discard_status_t discard_status;
+  /* Request writers matched by request_sub, refreshed whenever the
+     reader's matched status changes */
+  std::vector<rmw_gid_t> matched_clients;
+  DDS_Long matched_total_count;
+  DDS_Long matched_current_count;
+  /* A streamed reply, with the sequence numbers of the parts written so
+     far which may not have been acknowledged by its client's reply reader
+     yet. A busy stream is being used by send_response_part(). */
+  struct ReplyStream
+  {
+    rmw_gid_t client;
+    rmw_gid_t reader;
+    int64_t request_sn;
+    std::deque<int64_t> parts;
+    bool busy;
+  };
+
+  /* Max unacknowledged parts of each streamed reply (0 if the reply writer
+     is not reliable), and max time to wait for their acknowledgment */
+  size_t stream_window;
+  DDS_Duration_t stream_max_wait;
+  /* Streamed replies whose last part hasn't been sent yet */
+  std::mutex stream_mutex;
+  std::list<ReplyStream> streams;
+
+  RMW_Connext_Service()
+  : reply_pub(nullptr),
+    request_sub(nullptr),
+    discard_departed(false),
+    request_max_age_ms(0),
+    discard_status{0, 0, 0},
+    matched_total_count(-1),
+    matched_current_count(-1),
+    stream_window(0),
+    stream_max_wait(DDS_DURATION_INFINITE)
+  {}
+
+  // Check whether the writer of a request is still matched, refreshing
+  // matched_clients if needed. Must be called with discard_mutex held.
+  bool
+  client_matched(const DDS_InstanceHandle_t & request_writer);
+
+  // Find the reply reader of the client with the given request writer.
+  rmw_ret_t
+  find_reply_reader(
+    const rmw_gid_t & client,
+    rmw_gid_t & reader,
+    bool & found);
+
+  // Drop the streams (not in use) whose client's reply reader is no longer
+  // matched. Must be called with stream_mutex held.
+  void
+  drop_departed_streams();
 
 public:
   static
@@ -1207,10 +1509,44 @@ public:
     void * const ros_request,
     bool * const taken);
 
+  // Check whether a request (before it is deserialized) is still relevant,
+  // i.e. its client is still matched and it isn't older than the max age.
+  bool
+  accept_request(const DDS_SampleInfo * const info);
+
+  void
+  set_request_discard(
+    const bool discard_departed,
+    const int64_t max_age_ms)
+  {
+    std::lock_guard<std::mutex> guard(this->discard_mutex);
+    this->discard_departed = discard_departed;
+    this->request_max_age_ms = max_age_ms;
+  }
+
+  void
+  request_discard_status(rmw_connextdds_request_discard_status_t & status)
+  {
+    std::lock_guard<std::mutex> guard(this->discard_mutex);
+    status = this->discard_status;
+    this->discard_status.total_count_change = 0;
+  }
+
   rmw_ret_t
   send_response(
     rmw_request_id_t * const request_id,
-    const void * const ros_response);
+    const void * const ros_response,
+    const bool last = true,
+    int64_t * const sn_out = nullptr);
+
+  // Send a part of a streamed response, once enough of its previous parts
+  // have been acknowledged by the client. The parts of a response must not
+  // be sent concurrently by multiple threads.
+  rmw_ret_t
+  send_response_part(
+    rmw_request_id_t * const request_id,
+    const void * const ros_response,
+    const bool last);
 
   RMW_Connext_Publisher *
   publisher() const
@@ -1323,6 +1659,9 @@ rmw_connextdds_waitset_wait(
  * GUID helpers
  ******************************************************************************/
 
+/* Size of the prefix shared by the GUIDs of all entities of a participant */
+#define RMW_CONNEXT_GUID_PREFIX_SIZE        12
+
 rmw_ret_t
 rmw_connextdds_gid_to_guid(const rmw_gid_t & gid, struct DDS_GUID_t & guid);
 
@@ -1421,6 +1760,71 @@ rmw_connextdds_create_topic_name(
   const char * suffix,
   const rmw_qos_profile_t * qos_policies);
 
+// Match a name against a glob pattern, which may contain '*' (any sequence
+// of characters) and '?' (any single character) wildcards.
+bool
+rmw_connextdds_match_pattern(
+  const char * const pattern,
+  const char * const name);
+
+// Find the first QoS override whose pattern matches a topic name, or the
+// name of its type (nullptr if none).
+const RMW_Connext_QosOverride *
+rmw_connextdds_find_qos_override(
+  rmw_context_impl_t * const ctx,
+  const char * const topic_name,
+  const char * const type_name);
+
+// Settings of the reliability protocol selected by a preset. Periods and
+// delays are in milliseconds, window sizes in samples (0 for unlimited).
+struct RMW_Connext_ReliabilityProtocol
+{
+  /* Writer settings */
+  int32_t heartbeat_period_ms;
+  int32_t fast_heartbeat_period_ms;
+  int32_t nack_response_delay_ms;
+  int32_t heartbeats_per_max_samples;
+  int32_t send_window_min;
+  int32_t send_window_max;
+  /* Reader settings */
+  int32_t heartbeat_response_delay_ms;
+  int32_t nack_period_ms;
+};
+
+// Look up the settings of a reliability preset. Returns false for
+// RELIABILITY_PRESET_DEFAULT, in which case endpoints should keep the
+// settings of their QoS profile.
+bool
+rmw_connextdds_get_reliability_preset(
+  const RMW_Connext_QosOverride::ReliabilityPreset preset,
+  RMW_Connext_ReliabilityProtocol * const protocol);
+
+inline
+void
+rmw_connextdds_duration_from_ms(
+  const int64_t ms,
+  DDS_Duration_t * const duration)
+{
+  duration->sec = static_cast<DDS_Long>(ms / 1000);
+  duration->nanosec = static_cast<DDS_UnsignedLong>((ms % 1000) * 1000000);
+}
+
+// Check whether a request (serialized with its request header) should be
+// handled by the server which owns the specified request reader.
+bool
+rmw_connextdds_request_target_matches(
+  const rcutils_uint8_array_t * const data_buffer,
+  const rmw_gid_t * const reader_gid);
+
+// Parse a content filter which selects replies by the GUID of the writer
+// that sent the related request (i.e. the filter used by a client's reply
+// reader), so that it may be evaluated by the reader itself on DDS
+// implementations without content-filtered topics.
+rmw_ret_t
+rmw_connextdds_parse_related_writer_filter(
+  const char * const filter,
+  DDS_GUID_t * const writer_guid);
+
 /******************************************************************************
  * Qos Helpers
  ******************************************************************************/
@@ -1439,6 +1843,7 @@ rmw_ret_t
 #if RMW_CONNEXT_HAVE_LIFESPAN_QOS
   DDS_LifespanQosPolicy * const lifespan,
 #endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS */
+  const RMW_Connext_QosOverride * const qos_override,
   const rmw_qos_profile_t * const qos_policies
 #if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
   ,
@@ -1447,6 +1852,27 @@ rmw_ret_t
 #endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
   );
 
+rmw_ret_t
+  rmw_connextdds_get_writer_blocking_qos(
+  rmw_context_impl_t * const ctx,
+  DDS_ReliabilityQosPolicy * const reliability
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  ,
+  const rmw_publisher_options_t * const pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  );
+
+// Transport priority requested for a writer, either via its publisher
+// options, or via a QoS override (0 if none).
+int32_t
+rmw_connextdds_get_writer_transport_priority(
+  const RMW_Connext_QosOverride * const qos_override
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  ,
+  const rmw_publisher_options_t * const pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+);
+
 rmw_ret_t
   rmw_connextdds_readerwriter_qos_to_ros(
   const DDS_HistoryQosPolicy * const history,
@@ -45,6 +45,55 @@
 #define RMW_CONNEXT_ENV_QOS_LIBRARY     "RMW_CONNEXT_QOS_LIBRARY"
 #endif /* RMW_CONNEXT_ENV_QOS_LIBRARY */
 
+#ifndef RMW_CONNEXT_ENV_DESERIALIZE_THREADS
+#define RMW_CONNEXT_ENV_DESERIALIZE_THREADS   "RMW_CONNEXT_DESERIALIZE_THREADS"
+#endif /* RMW_CONNEXT_ENV_DESERIALIZE_THREADS */
+
+#ifndef RMW_CONNEXT_ENV_PUBSUB_SCOPE
+#define RMW_CONNEXT_ENV_PUBSUB_SCOPE    "RMW_CONNEXT_PUBSUB_SCOPE"
+#endif /* RMW_CONNEXT_ENV_PUBSUB_SCOPE */
+
+#ifndef RMW_CONNEXT_ENV_PARTICIPANT_SCOPE
+#define RMW_CONNEXT_ENV_PARTICIPANT_SCOPE   "RMW_CONNEXT_PARTICIPANT_SCOPE"
+#endif /* RMW_CONNEXT_ENV_PARTICIPANT_SCOPE */
+
+#ifndef RMW_CONNEXT_ENV_WRITE_BLOCKING_TIME
+#define RMW_CONNEXT_ENV_WRITE_BLOCKING_TIME   "RMW_CONNEXT_WRITE_BLOCKING_TIME"
+#endif /* RMW_CONNEXT_ENV_WRITE_BLOCKING_TIME */
+
+#ifndef RMW_CONNEXT_ENV_REQUEST_TIMEOUT
+#define RMW_CONNEXT_ENV_REQUEST_TIMEOUT   "RMW_CONNEXT_REQUEST_TIMEOUT"
+#endif /* RMW_CONNEXT_ENV_REQUEST_TIMEOUT */
+
+#ifndef RMW_CONNEXT_ENV_REQUEST_MAX_AGE
+#define RMW_CONNEXT_ENV_REQUEST_MAX_AGE   "RMW_CONNEXT_REQUEST_MAX_AGE"
+#endif /* RMW_CONNEXT_ENV_REQUEST_MAX_AGE */
+
+#ifndef RMW_CONNEXT_ENV_DISCARD_DEPARTED_REQUESTS
+#define RMW_CONNEXT_ENV_DISCARD_DEPARTED_REQUESTS \
+  "RMW_CONNEXT_DISCARD_DEPARTED_REQUESTS"
+#endif /* RMW_CONNEXT_ENV_DISCARD_DEPARTED_REQUESTS */
+
+#ifndef RMW_CONNEXT_ENV_QOS_OVERRIDES
+#define RMW_CONNEXT_ENV_QOS_OVERRIDES   "RMW_CONNEXT_QOS_OVERRIDES"
+#endif /* RMW_CONNEXT_ENV_QOS_OVERRIDES */
+
+#ifndef RMW_CONNEXT_ENV_SERVER_SELECTION
+#define RMW_CONNEXT_ENV_SERVER_SELECTION  "RMW_CONNEXT_SERVER_SELECTION"
+#endif /* RMW_CONNEXT_ENV_SERVER_SELECTION */
+
+#ifndef RMW_CONNEXT_ENV_QOS_OVERRIDES_FILE
+#define RMW_CONNEXT_ENV_QOS_OVERRIDES_FILE  "RMW_CONNEXT_QOS_OVERRIDES_FILE"
+#endif /* RMW_CONNEXT_ENV_QOS_OVERRIDES_FILE */
+
+#ifndef RMW_CONNEXT_ENV_TYPE_BOUNDS
+#define RMW_CONNEXT_ENV_TYPE_BOUNDS     "RMW_CONNEXT_TYPE_BOUNDS"
+#endif /* RMW_CONNEXT_ENV_TYPE_BOUNDS */
+
+#ifndef RMW_CONNEXT_ENV_TYPE_BOUNDS_FILE
+#define RMW_CONNEXT_ENV_TYPE_BOUNDS_FILE  "RMW_CONNEXT_TYPE_BOUNDS_FILE"
+#endif /* RMW_CONNEXT_ENV_TYPE_BOUNDS_FILE */
+
 /******************************************************************************
  * DDS Implementation
  * Select the DDS implementation used to build the RMW library.
@@ -109,6 +158,87 @@
   (RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_MICRO)
 #endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
 
+/******************************************************************************
+ * Exclusive server selection.
+ * If this option is enabled (together with RMW_CONNEXT_EMULATE_REQUESTREPLY),
+ * the request header also contains the GID of the request reader of the
+ * server which should handle the request (or all zeros for any server), and
+ * servers drop requests targeted to other servers before deserializing them.
+ * Clients select a server for each request according to the policy set with
+ * RMW_CONNEXT_SERVER_SELECTION (by default, requests are sent to all servers).
+ * Since it changes the request header, this option must be enabled at build
+ * time by all applications which exchange requests.
+ * Servers advertise their request reader in their reply writer's discovery
+ * data. Connext Micro doesn't propagate it, so clients only select among
+ * Micro servers which don't share their participant with another server
+ * for the same service.
+ ******************************************************************************/
+#ifndef RMW_CONNEXT_EMULATE_REQUESTREPLY_TARGET
+#define RMW_CONNEXT_EMULATE_REQUESTREPLY_TARGET     0
+#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY_TARGET */
+
+#ifndef RMW_CONNEXT_HAVE_REQUEST_TARGET
+#define RMW_CONNEXT_HAVE_REQUEST_TARGET \
+  (RMW_CONNEXT_EMULATE_REQUESTREPLY && RMW_CONNEXT_EMULATE_REQUESTREPLY_TARGET)
+#endif /* RMW_CONNEXT_HAVE_REQUEST_TARGET */
+
+/******************************************************************************
+ * Request priorities.
+ * If this option is enabled (together with RMW_CONNEXT_EMULATE_REQUESTREPLY),
+ * the request header also contains a priority assigned by the client (see
+ * rmw_api_connextdds_client_set_request_priority()), and services take the
+ * requests contained in each batch of loaned samples in order of decreasing
+ * priority (and in arrival order among requests with the same priority).
+ * Since it changes the request header, this option must be enabled at build
+ * time by all applications which exchange requests.
+ ******************************************************************************/
+#ifndef RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY
+#define RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY   0
+#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY */
+
+#ifndef RMW_CONNEXT_HAVE_REQUEST_PRIORITY
+#define RMW_CONNEXT_HAVE_REQUEST_PRIORITY \
+  (RMW_CONNEXT_EMULATE_REQUESTREPLY && RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY)
+#endif /* RMW_CONNEXT_HAVE_REQUEST_PRIORITY */
+
+/******************************************************************************
+ * Streamed replies.
+ * Services may send a response as an ordered sequence of parts (see
+ * rmw_api_connextdds_send_response_part()). All parts but the last one are
+ * marked as intermediate with DDS_INTERMEDIATE_REPLY_SEQUENCE_SAMPLE or, if
+ * RMW_CONNEXT_EMULATE_REQUESTREPLY is enabled, with flags added to the reply
+ * header. Since it changes the reply header, the emulated version must be
+ * enabled at build time by all applications which exchange replies.
+ * With a reliable reply writer, each stream may only have up to
+ * RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW parts which haven't been acknowledged
+ * by its client yet. With Connext Pro, the acknowledgment state of the client
+ * is polled every RMW_CONNEXT_REPLY_STREAM_POLL_PERIOD_MS while waiting.
+ ******************************************************************************/
+#ifndef RMW_CONNEXT_EMULATE_REQUESTREPLY_STREAM
+#define RMW_CONNEXT_EMULATE_REQUESTREPLY_STREAM     0
+#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY_STREAM */
+
+#ifndef RMW_CONNEXT_HAVE_REPLY_STREAM
+#define RMW_CONNEXT_HAVE_REPLY_STREAM \
+  (!RMW_CONNEXT_EMULATE_REQUESTREPLY || RMW_CONNEXT_EMULATE_REQUESTREPLY_STREAM)
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
+
+#ifndef RMW_CONNEXT_REPLY_STREAM_POLL_PERIOD_MS
+#define RMW_CONNEXT_REPLY_STREAM_POLL_PERIOD_MS     1
+#endif /* RMW_CONNEXT_REPLY_STREAM_POLL_PERIOD_MS */
+
+/******************************************************************************
+ * Type hash matching.
+ * If enabled, a hash of the structure of each type (computed from its
+ * introspection type support) is advertised in the USER_DATA of endpoints,
+ * and remote endpoints whose type has the same name as a local type, but a
+ * different hash, are ignored instead of being matched (only with Pro, since
+ * Micro doesn't propagate the USER_DATA of endpoints).
+ ******************************************************************************/
+#ifndef RMW_CONNEXT_TYPE_HASH
+#define RMW_CONNEXT_TYPE_HASH     RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+#endif /* RMW_CONNEXT_TYPE_HASH */
+
 /******************************************************************************
  * Shmem Transport.
  * If disabled, the shared memory transport will not be used by the
@@ -118,6 +248,67 @@
 #define RMW_CONNEXT_TRANSPORT_SHMEM     1
 #endif /* RMW_CONNEXT_TRANSPORT_SHMEM */
 
+/******************************************************************************
+ * Parallel deserialization.
+ * When RMW_CONNEXT_DESERIALIZE_THREADS is set to a value greater than 1,
+ * samples taken with rmw_take_sequence() will be deserialized concurrently by
+ * up to that many threads (the taking thread, and worker threads started
+ * with the DomainParticipant), as long as at least
+ * RMW_CONNEXT_PARALLEL_DESERIALIZE_MIN_SAMPLES samples were actually taken.
+ * This is mostly useful for topics carrying large messages (e.g. images,
+ * point clouds), where the cost of handing samples over to the workers is
+ * small compared to the cost of deserializing each sample.
+ ******************************************************************************/
+#ifndef RMW_CONNEXT_PARALLEL_DESERIALIZE_MIN_SAMPLES
+#define RMW_CONNEXT_PARALLEL_DESERIALIZE_MIN_SAMPLES  2
+#endif /* RMW_CONNEXT_PARALLEL_DESERIALIZE_MIN_SAMPLES */
+
+/******************************************************************************
+ * Fast teardown.
+ * Once all rmw contexts using a DomainParticipant have been shut down, the
+ * deletion of local entities is no longer announced to other participants,
+ * which will purge all of the participant's entities once it is deleted.
+ * If RMW_CONNEXT_FAST_TEARDOWN is enabled, endpoints and topics are also not
+ * deleted one by one, and they are instead released in a single pass by
+ * DDS_DomainParticipant_delete_contained_entities(). Their type supports,
+ * which are referenced by the registered type plugins, are kept by the
+ * context until the DomainParticipant has been deleted. This is only
+ * supported by Connext Pro, since Micro's type plugins are owned by the RMW
+ * and must be released explicitly by each endpoint.
+ ******************************************************************************/
+#ifndef RMW_CONNEXT_FAST_TEARDOWN
+#if RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO
+#define RMW_CONNEXT_FAST_TEARDOWN     1
+#else
+#define RMW_CONNEXT_FAST_TEARDOWN     0
+#endif /* RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO */
+#endif /* RMW_CONNEXT_FAST_TEARDOWN */
+
+/******************************************************************************
+ * Flow controllers.
+ * Publishers with a limited rate (see RMW_CONNEXT_QOS_OVERRIDES and
+ * rmw_connextdds_publisher_options_t) are attached to a token-bucket flow
+ * controller, which is only supported by Connext Pro. Tokens are refilled
+ * every RMW_CONNEXT_FLOW_CONTROLLER_PERIOD_MS, and they are small compared to
+ * the fragments of large messages, so that bandwidth is shaped smoothly.
+ * Unless specified, the burst size allows a whole UDP datagram to be sent.
+ ******************************************************************************/
+#ifndef RMW_CONNEXT_FLOW_CONTROLLER_PERIOD_MS
+#define RMW_CONNEXT_FLOW_CONTROLLER_PERIOD_MS         10
+#endif /* RMW_CONNEXT_FLOW_CONTROLLER_PERIOD_MS */
+
+#ifndef RMW_CONNEXT_FLOW_CONTROLLER_BYTES_PER_TOKEN
+#define RMW_CONNEXT_FLOW_CONTROLLER_BYTES_PER_TOKEN   1024
+#endif /* RMW_CONNEXT_FLOW_CONTROLLER_BYTES_PER_TOKEN */
+
+#ifndef RMW_CONNEXT_FLOW_CONTROLLER_BURST_DEFAULT
+#define RMW_CONNEXT_FLOW_CONTROLLER_BURST_DEFAULT     65536
+#endif /* RMW_CONNEXT_FLOW_CONTROLLER_BURST_DEFAULT */
+
+#ifndef RMW_CONNEXT_FLOW_CONTROLLER_PREFIX
+#define RMW_CONNEXT_FLOW_CONTROLLER_PREFIX            "rmw_connextdds.flow:"
+#endif /* RMW_CONNEXT_FLOW_CONTROLLER_PREFIX */
+
 /******************************************************************************
  * ROS Target Release
  ******************************************************************************/
@@ -214,6 +405,13 @@
   (RMW_CONNEXT_RELEASE > RMW_CONNEXT_RELEASE_ELOQUENT)
 #endif /* RMW_CONNEXT_HAVE_GET_INFO_BY_TOPIC */
 
+/* No ROS release allows rmw_publish(), rmw_send_request(), and
+   rmw_send_response() to fail with RMW_RET_TIMEOUT, so writes which time out
+   are reported with RMW_RET_ERROR (and counted by the publisher). */
+#ifndef RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT
+#define RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT    0
+#endif /* RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT */
+
 #ifndef RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
 #define RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT \
   (RMW_CONNEXT_RELEASE >= RMW_CONNEXT_RELEASE_DASHING)
@@ -48,6 +48,15 @@ struct RMW_Connext_RequestReplyMessage
   bool request;
   rmw_gid_t gid;
   int64_t sn;
+  /* GID of the server's request reader which should handle a request, or
+     all zeros for any server (see RMW_CONNEXT_EMULATE_REQUESTREPLY_TARGET) */
+  rmw_gid_t target;
+  /* Priority of a request, higher values are taken first by the server
+     (see RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY) */
+  int32_t priority;
+  /* Whether a reply is followed by more parts of the same response
+     (see RMW_CONNEXT_HAVE_REPLY_STREAM) */
+  bool intermediate;
   void * payload;
 };
 
@@ -55,18 +64,35 @@ class RMW_Connext_MessageTypeSupport
 {
   const rosidl_message_type_support_t * _type_support_fastrtps;
   bool _unbounded;
+  /* Unbounded type with bounds declared by the user
+     (see RMW_Connext_TypeBounds) */
+  bool _bounds_declared;
+  /* Declared max length of unbounded strings and sequences, checked for
+     each member before serializing a sample (negative if not declared) */
+  int32_t _max_string;
+  int32_t _max_sequence;
+  /* Introspection members used to check the declared bounds */
+  const void * _bounds_members;
+  bool _bounds_members_cpp;
   bool _empty;
   uint32_t _serialized_size_max;
   std::string _type_name;
   RMW_Connext_MessageType _message_type;
+  /* Hash of the type's structure (0 if unknown) */
+  uint64_t _type_hash;
 
 public:
   static const uint32_t ENCAPSULATION_HEADER_SIZE = 4;
+  /* Flags of the (emulated) reply header */
+  static const int32_t REPLY_FLAG_INTERMEDIATE = 0x1;
 
   RMW_Connext_MessageTypeSupport(
     const RMW_Connext_MessageType message_type,
     const rosidl_message_type_support_t * const type_supports,
-    const char * const type_name);
+    const char * const type_name,
+    rmw_context_impl_t * const ctx = nullptr,
+    const void * const intro_members = nullptr,
+    const bool intro_members_cpp = false);
 
   const message_type_support_callbacks_t * callbacks_fastrtps()
   {
@@ -100,11 +126,21 @@ public:
            this->_message_type == RMW_CONNEXT_MESSAGE_REPLY;
   }
 
+  bool type_request() const
+  {
+    return this->_message_type == RMW_CONNEXT_MESSAGE_REQUEST;
+  }
+
   bool type_userdata() const
   {
     return this->_message_type == RMW_CONNEXT_MESSAGE_USERDATA;
   }
 
+  uint64_t type_hash() const
+  {
+    return this->_type_hash;
+  }
+
   uint32_t serialized_size_max(
     const void * const ros_msg,
     const bool include_encapsulation = true);
@@ -130,10 +166,13 @@ public:
     const bool intro_members_cpp = false,
     std::string * const type_name = nullptr);
 
+  // If keep_registered is true, only the type's reference count is
+  // decreased, and the type is left to be deleted with the participant.
   static rmw_ret_t unregister_type_support(
     rmw_context_impl_t * const ctx,
     DDS_DomainParticipant * const participant,
-    const char * const type_name);
+    const char * const type_name,
+    const bool keep_registered = false);
 
   static const rosidl_message_type_support_t * get_type_support_fastrtps(
     const rosidl_message_type_support_t * const type_supports);
@@ -144,11 +183,31 @@ public:
     bool & cpp_version);
 #endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
 
+  // Compute a hash of the structure of a type, from its introspection type
+  // support (0 if not available). Hashes are cached for each type.
+  static uint64_t compute_type_hash(
+    const rosidl_message_type_support_t * const type_supports,
+    const void * const intro_members = nullptr,
+    const bool intro_members_cpp = false);
+
   static void type_info(
     const rosidl_message_type_support_t * const type_support,
     uint32_t & serialized_size_max,
     bool & unbounded,
     bool & empty);
+
+private:
+  // Compute a finite max serialized size for an unbounded type, from the
+  // bounds declared for it (if any), and handle it as a bounded type.
+  void apply_type_bounds(
+    rmw_context_impl_t * const ctx,
+    const rosidl_message_type_support_t * const type_supports,
+    const void * const intro_members,
+    const bool intro_members_cpp);
+
+  // Check that every unbounded string and sequence of a sample is within
+  // the bounds declared for the type.
+  rmw_ret_t check_type_bounds(const void * const ros_msg);
 };
 
 struct RMW_Connext_Message
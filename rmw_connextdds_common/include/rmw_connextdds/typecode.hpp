@@ -16,6 +16,7 @@
 #define RMW_CONNEXTDDS__TYPECODE_HPP_
 
 #include "rmw_connextdds/type_support.hpp"
+#include "rmw_connextdds/visibility_control.h"
 
 DDS_SEQUENCE(RMW_Connext_TypeCodePtrSeq, DDS_TypeCode *);
 
@@ -34,4 +35,42 @@ void
 rmw_connextdds_release_typecode_cache(
   RMW_Connext_TypeCodePtrSeq * const tc_cache);
 
+/* Function returning a precomputed TypeCode, e.g. the "<type>_get_typecode()"
+   functions generated by rtiddsgen. The TypeCode is owned by the provider. */
+typedef DDS_TypeCode * (*RMW_Connext_TypeCodeProvider)(void);
+
+/* Register a precomputed TypeCode for a (mangled) DDS type name, which will
+   be used instead of generating one from the type's introspection type
+   support. type_hash is the hash of the type's structure that the TypeCode
+   was checked against (see rmw_connextdds_check_typecode()): the TypeCode is
+   ignored if the type's current hash differs, e.g. because the message was
+   changed after the TypeCode was built. Libraries built with
+   rmw_connextdds_generate_typecodes() call this function when they are
+   loaded. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_register_typecode(
+  const char * const type_name,
+  RMW_Connext_TypeCodeProvider provider,
+  const uint64_t type_hash);
+
+/* Check that a precomputed TypeCode matches the one generated from a type's
+   introspection type support, and return the hash of the type's structure
+   to register with it. Called at build time by rmw_connextdds_generate_typecodes(),
+   so that the comparison doesn't slow down applications at runtime. */
+RMW_CONNEXTDDS_PUBLIC
+rmw_ret_t
+rmw_connextdds_check_typecode(
+  const rosidl_message_type_support_t * const type_supports,
+  const char * const type_name,
+  const DDS_TypeCode * const precomputed_tc,
+  uint64_t * const type_hash);
+
+// Return a copy of the precomputed TypeCode registered for a type (and the
+// hash it was registered with), or nullptr if none was registered.
+DDS_TypeCode *
+rmw_connextdds_lookup_typecode(
+  const char * const type_name,
+  uint64_t * const type_hash = nullptr);
+
 #endif  // RMW_CONNEXTDDS__TYPECODE_HPP_
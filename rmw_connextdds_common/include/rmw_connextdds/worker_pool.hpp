@@ -0,0 +1,78 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_CONNEXTDDS__WORKER_POOL_HPP_
+#define RMW_CONNEXTDDS__WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rmw_connextdds/visibility_control.h"
+
+/* Fixed set of threads which help a caller run a batch of independent jobs.
+   The threads are started when the pool is created, and they are stopped
+   when it is deleted, so that running a batch only costs a few wake-ups. */
+class RMW_CONNEXTDDS_PUBLIC RMW_Connext_WorkerPool
+{
+public:
+  typedef std::function<void (size_t)> Job;
+
+  // Start `threads_len` worker threads. Throws std::system_error if a
+  // thread cannot be started.
+  explicit RMW_Connext_WorkerPool(const size_t threads_len);
+
+  ~RMW_Connext_WorkerPool();
+
+  RMW_Connext_WorkerPool(const RMW_Connext_WorkerPool &) = delete;
+  RMW_Connext_WorkerPool & operator=(const RMW_Connext_WorkerPool &) = delete;
+
+  size_t
+  threads_len() const
+  {
+    return this->threads.size();
+  }
+
+  // Call job(i) for every i in [0, jobs_len), using both the worker threads
+  // and the calling thread, and return once all calls have completed.
+  // Batches submitted concurrently are run one after the other.
+  void
+  run(const size_t jobs_len, const Job & job);
+
+private:
+  void
+  worker_main();
+
+  // Run jobs of the current batch until none is left to claim.
+  // Must be called with `lock` held, which is released while running a job.
+  void
+  run_jobs(std::unique_lock<std::mutex> & lock);
+
+  std::mutex run_mutex;
+
+  std::mutex mutex;
+  std::condition_variable cond_work;
+  std::condition_variable cond_done;
+  const Job * job{nullptr};
+  size_t jobs_len{0};
+  size_t jobs_next{0};
+  size_t jobs_done{0};
+  bool stopping{false};
+
+  std::vector<std::thread> threads;
+};
+
+#endif  // RMW_CONNEXTDDS__WORKER_POOL_HPP_
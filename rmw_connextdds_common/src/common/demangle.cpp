@@ -14,7 +14,10 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "rcpputils/find_and_replace.hpp"
@@ -22,6 +25,7 @@
 #include "rcutils/types.h"
 #include "rmw_connextdds/namespace_prefix.hpp"
 #include "rmw_connextdds/demangle.hpp"
+#include "rmw_connextdds/resource_limits.hpp"
 
 extern "C"
 {
@@ -33,6 +37,62 @@ const std::vector<std::string> _ros_prefixes =
 {ROS_TOPIC_PREFIX, ROS_SERVICE_REQUESTER_PREFIX, ROS_SERVICE_RESPONSE_PREFIX};
 }  // extern "C"
 
+namespace
+{
+/// Cache of the names returned by _demangle_if_ros_topic() and
+/// _demangle_if_ros_type(), which are called for every discovered endpoint.
+/**
+ * Entries are keyed by the demangled name's kind followed by the mangled
+ * name. Demangling only depends on the mangled name, so entries never need
+ * to be invalidated, and the cache is simply cleared once it is full.
+ */
+struct DemangleCache
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, std::string> names;
+};
+
+DemangleCache &
+_demangle_cache()
+{
+  static DemangleCache cache;
+  return cache;
+}
+
+std::string
+_demangle_cached(
+  const char kind,
+  const std::string & name,
+  DemangleFunction demangle_fn)
+{
+  DemangleCache & cache = _demangle_cache();
+  std::string key;
+  key.reserve(name.length() + 1);
+  key += kind;
+  key += name;
+  {
+    std::lock_guard<std::mutex> guard(cache.mutex);
+    auto cached = cache.names.find(key);
+    if (cached != cache.names.end()) {
+      return cached->second;
+    }
+  }
+
+  std::string demangled = demangle_fn(name);
+
+  std::lock_guard<std::mutex> guard(cache.mutex);
+  try {
+    if (cache.names.size() >= RMW_CONNEXT_LIMIT_DEMANGLE_CACHE_MAX) {
+      cache.names.clear();
+    }
+    cache.names.emplace(std::move(key), demangled);
+  } catch (const std::exception &) {
+    // The name will simply be demangled again.
+  }
+  return demangled;
+}
+}  // namespace
+
 /// Returns `name` stripped of `prefix`.
 std::string
 _resolve_prefix(const std::string & name, const std::string & prefix)
@@ -59,12 +119,12 @@ _strip_ros_prefix_if_exists(const std::string & topic_name)
 std::string
 _demangle_if_ros_topic(const std::string & topic_name)
 {
-  return _strip_ros_prefix_if_exists(topic_name);
+  return _demangle_cached('t', topic_name, _strip_ros_prefix_if_exists);
 }
 
-/// Return the demangled ROS type or the original if not a ROS type.
+static
 std::string
-_demangle_if_ros_type(const std::string & dds_type_string)
+_demangle_if_ros_type_uncached(const std::string & dds_type_string)
 {
   if (dds_type_string[dds_type_string.size() - 1] != '_') {
     // not a ROS type
@@ -85,6 +145,13 @@ _demangle_if_ros_type(const std::string & dds_type_string)
   return type_namespace + type_name;
 }
 
+/// Return the demangled ROS type or the original if not a ROS type.
+std::string
+_demangle_if_ros_type(const std::string & dds_type_string)
+{
+  return _demangle_cached('y', dds_type_string, _demangle_if_ros_type_uncached);
+}
+
 /// Return the topic name for a given topic if it is part of one, else "".
 std::string
 _demangle_ros_topic_from_topic(const std::string & topic_name)
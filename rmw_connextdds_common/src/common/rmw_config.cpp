@@ -0,0 +1,222 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rmw_connextdds/config.hpp"
+#include "rmw_connextdds/log.hpp"
+
+#include "rcutils/get_env.h"
+
+#include "rmw/error_handling.h"
+
+rmw_ret_t
+rmw_connextdds_get_env(
+  const char * const name,
+  const char ** const value)
+{
+  *value = nullptr;
+  const char * const lookup_rc = rcutils_get_env(name, value);
+
+  if (nullptr != lookup_rc || nullptr == *value) {
+    RMW_CONNEXT_LOG_ERROR_A_SET(
+      "failed to lookup from environment: "
+      "var=%s, "
+      "rc=%s ",
+      name,
+      lookup_rc)
+    return RMW_RET_ERROR;
+  }
+
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_get_env_int64(
+  const char * const name,
+  const int64_t min_value,
+  int64_t & value)
+{
+  const char * str = nullptr;
+  if (RMW_RET_OK != rmw_connextdds_get_env(name, &str)) {
+    return RMW_RET_ERROR;
+  }
+
+  if (strlen(str) == 0) {
+    return RMW_RET_OK;
+  }
+
+  char * end = nullptr;
+  errno = 0;
+  const long long parsed =  // NOLINT(runtime/int)
+    strtoll(str, &end, 10);
+  if (end == str || *end != '\0' || ERANGE == errno || parsed < min_value) {
+    RMW_CONNEXT_LOG_ERROR_A_SET(
+      "invalid value for %s: '%s' (expected: integer >= %lld)",
+      name, str, static_cast<long long>(min_value))  // NOLINT(runtime/int)
+    return RMW_RET_ERROR;
+  }
+
+  value = static_cast<int64_t>(parsed);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_get_env_bool(
+  const char * const name,
+  bool & value)
+{
+  size_t choice = value ? 1 : 0;
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_choice(name, {"0", "1"}, choice))
+  {
+    return RMW_RET_ERROR;
+  }
+  value = (1 == choice);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_get_env_choice(
+  const char * const name,
+  const std::initializer_list<const char *> choices,
+  size_t & choice)
+{
+  const char * str = nullptr;
+  if (RMW_RET_OK != rmw_connextdds_get_env(name, &str)) {
+    return RMW_RET_ERROR;
+  }
+
+  if (strlen(str) == 0) {
+    return RMW_RET_OK;
+  }
+
+  std::string expected;
+  size_t i = 0;
+  for (const char * const c : choices) {
+    if (strcmp(str, c) == 0) {
+      choice = i;
+      return RMW_RET_OK;
+    }
+    expected += (i > 0) ? ", '" : "'";
+    expected += c;
+    expected += "'";
+    i += 1;
+  }
+
+  RMW_CONNEXT_LOG_ERROR_A_SET(
+    "invalid value for %s: '%s' (expected: %s)",
+    name, str, expected.c_str())
+  return RMW_RET_ERROR;
+}
+
+static
+std::string
+rmw_connextdds_trim(const std::string & str)
+{
+  const size_t begin = str.find_first_not_of(" \t\r");
+  if (std::string::npos == begin) {
+    return std::string();
+  }
+  return str.substr(begin, str.find_last_not_of(" \t\r") - begin + 1);
+}
+
+rmw_ret_t
+rmw_connextdds_parse_config_table(
+  const char * const source,
+  std::istream & table,
+  const char delimiter,
+  std::vector<RMW_Connext_ConfigEntry> & entries)
+{
+  std::string line;
+  while (std::getline(table, line, delimiter)) {
+    RMW_Connext_ConfigEntry entry;
+    entry.source = source;
+    entry.text = rmw_connextdds_trim(line.substr(0, line.find('#')));
+    if (entry.text.empty()) {
+      continue;
+    }
+
+    // Patterns may contain "::" (e.g. DDS type names), so the pattern ends
+    // at the last ':' before the first setting.
+    const size_t sep = entry.text.rfind(':', entry.text.find('='));
+    entry.pattern = rmw_connextdds_trim(entry.text.substr(0, sep));
+    bool valid = std::string::npos != sep && !entry.pattern.empty();
+
+    std::istringstream settings(
+      (std::string::npos != sep) ? entry.text.substr(sep + 1) : "");
+    std::string setting;
+    while (valid && std::getline(settings, setting, ',')) {
+      const size_t eq = setting.find('=');
+      const std::string key = rmw_connextdds_trim(setting.substr(0, eq));
+      valid = std::string::npos != eq && !key.empty();
+      if (valid) {
+        entry.settings.emplace_back(
+          key, rmw_connextdds_trim(setting.substr(eq + 1)));
+      }
+    }
+
+    if (!valid) {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "invalid entry in %s: '%s'", source, entry.text.c_str())
+      return RMW_RET_ERROR;
+    }
+
+    entries.push_back(std::move(entry));
+  }
+
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_get_env_table(
+  const char * const name,
+  const char * const file_name,
+  std::vector<RMW_Connext_ConfigEntry> & entries)
+{
+  const char * table = nullptr;
+  const char * table_file = nullptr;
+  if (RMW_RET_OK != rmw_connextdds_get_env(name, &table) ||
+    RMW_RET_OK != rmw_connextdds_get_env(file_name, &table_file))
+  {
+    return RMW_RET_ERROR;
+  }
+
+  std::istringstream table_stream(table);
+  if (RMW_RET_OK !=
+    rmw_connextdds_parse_config_table(name, table_stream, ';', entries))
+  {
+    return RMW_RET_ERROR;
+  }
+
+  if (strlen(table_file) == 0) {
+    return RMW_RET_OK;
+  }
+
+  std::ifstream table_fstream(table_file);
+  if (!table_fstream) {
+    RMW_CONNEXT_LOG_ERROR_A_SET(
+      "failed to open file: var=%s, file=%s", file_name, table_file)
+    return RMW_RET_ERROR;
+  }
+  return rmw_connextdds_parse_config_table(
+    table_file, table_fstream, '\n', entries);
+}
@@ -12,15 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdlib>
 #include <functional>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "rmw_connextdds/rmw_impl.hpp"
+#include "rmw_connextdds/config.hpp"
 #include "rmw_connextdds/discovery.hpp"
 #include "rmw_connextdds/graph_cache.hpp"
 
-#include "rcutils/get_env.h"
 #include "rcutils/filesystem.h"
 
 /******************************************************************************
@@ -34,6 +38,61 @@
  ******************************************************************************/
 DDS_DomainParticipantFactory * RMW_Connext_gv_DomainParticipantFactory = nullptr;
 
+/******************************************************************************
+ * Process-wide pool of context implementations which may be shared by
+ * multiple rmw contexts (see RMW_CONNEXT_ENV_PARTICIPANT_SCOPE). Contexts are
+ * only shared if they were initialized with compatible options, i.e. if they
+ * have the same "share key".
+ ******************************************************************************/
+static std::mutex RMW_Connext_gv_SharedContextsMutex;
+static std::map<std::string, rmw_context_impl_t *> RMW_Connext_gv_SharedContexts;
+
+static
+rmw_ret_t
+rmw_connextdds_get_context_share_key(
+  const rmw_context_t * const context,
+  const DDS_DomainId_t domain_id,
+  std::string & share_key)
+{
+  size_t participant_scope = 0;
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_choice(
+      RMW_CONNEXT_ENV_PARTICIPANT_SCOPE,
+      {"context", "process"},
+      participant_scope))
+  {
+    return RMW_RET_ERROR;
+  }
+
+  if (0 == participant_scope) {
+    share_key.clear();
+    return RMW_RET_OK;
+  }
+
+  // QoS library/profiles are selected via environment variables, and they
+  // are thus implicitly the same for all contexts in the process.
+  std::ostringstream key;
+  key << domain_id;
+#if RMW_CONNEXT_HAVE_LOCALHOST_ONLY
+  key << "|" << (context->options.localhost_only == RMW_LOCALHOST_ONLY_ENABLED);
+#endif /* RMW_CONNEXT_HAVE_LOCALHOST_ONLY */
+#if RMW_CONNEXT_HAVE_OPTIONS
+  key << "|" << context->options.enclave;
+#endif /* RMW_CONNEXT_HAVE_OPTIONS */
+#if RMW_CONNEXT_HAVE_SECURITY
+  const char * const security_root_path =
+    context->options.security_options.security_root_path;
+  key << "|" <<
+    static_cast<int>(context->options.security_options.enforce_security) <<
+    "|" << ((nullptr != security_root_path) ? security_root_path : "");
+#endif /* RMW_CONNEXT_HAVE_SECURITY */
+#if !RMW_CONNEXT_HAVE_LOCALHOST_ONLY && !RMW_CONNEXT_HAVE_OPTIONS
+  UNUSED_ARG(context);
+#endif /* !RMW_CONNEXT_HAVE_LOCALHOST_ONLY && !RMW_CONNEXT_HAVE_OPTIONS */
+  share_key = key.str();
+  return RMW_RET_OK;
+}
+
 
 /******************************************************************************
  * Context Implementation
@@ -91,16 +150,9 @@ rmw_connextdds_initialize_participant_qos(
 
   /* Lookup and configure initial peer from environment */
   const char * initial_peer = nullptr;
-  const char * lookup_rc =
-    rcutils_get_env(RMW_CONNEXT_ENV_INITIAL_PEER, &initial_peer);
-
-  if (nullptr != lookup_rc || nullptr == initial_peer) {
-    RMW_CONNEXT_LOG_ERROR_A_SET(
-      "failed to lookup from environment: "
-      "var=%s, "
-      "rc=%s ",
-      RMW_CONNEXT_ENV_INITIAL_PEER,
-      lookup_rc)
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env(RMW_CONNEXT_ENV_INITIAL_PEER, &initial_peer))
+  {
     return RMW_RET_ERROR;
   }
 
@@ -128,6 +180,147 @@ rmw_connextdds_initialize_participant_qos(
   return RMW_RET_OK;
 }
 
+static
+bool
+rmw_connextdds_parse_int32(
+  const std::string & str,
+  const int32_t min_value,
+  int32_t & value)
+{
+  char * end = nullptr;
+  const long long parsed =  // NOLINT(runtime/int)
+    strtoll(str.c_str(), &end, 10);
+  if (str.empty() || *end != '\0' || parsed < min_value || parsed > INT32_MAX) {
+    return false;
+  }
+  value = static_cast<int32_t>(parsed);
+  return true;
+}
+
+/* Parse the name of a reliability preset (see
+   rmw_connextdds_get_reliability_preset()). */
+static
+bool
+rmw_connextdds_parse_reliability_preset(
+  const std::string & str,
+  RMW_Connext_QosOverride::ReliabilityPreset & preset)
+{
+  if (str == "default") {
+    preset = RMW_Connext_QosOverride::RELIABILITY_PRESET_DEFAULT;
+  } else if (str == "low-latency") {
+    preset = RMW_Connext_QosOverride::RELIABILITY_PRESET_LOW_LATENCY;
+  } else if (str == "bulk") {
+    preset = RMW_Connext_QosOverride::RELIABILITY_PRESET_BULK;
+  } else if (str == "lossy-link") {
+    preset = RMW_Connext_QosOverride::RELIABILITY_PRESET_LOSSY_LINK;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/* Parse an entry of the QoS overrides table (see
+   rmw_connextdds_get_env_table()). */
+static
+bool
+rmw_connextdds_parse_qos_override(
+  const RMW_Connext_ConfigEntry & entry,
+  RMW_Connext_QosOverride & qos_override)
+{
+  qos_override.pattern = entry.pattern;
+  bool valid = true;
+  for (const auto & setting : entry.settings) {
+    const std::string & key = setting.first;
+    const std::string & value = setting.second;
+
+    if (key == "depth") {
+      valid = rmw_connextdds_parse_int32(value, 1, qos_override.depth);
+    } else if (key == "max_samples") {
+      valid = rmw_connextdds_parse_int32(value, 1, qos_override.max_samples);
+    } else if (key == "transport_priority") {
+      valid = rmw_connextdds_parse_int32(
+        value, 0, qos_override.transport_priority);
+    } else if (key == "flow_rate") {
+      valid = rmw_connextdds_parse_int32(value, 1, qos_override.flow_rate);
+    } else if (key == "flow_burst") {
+      valid = rmw_connextdds_parse_int32(value, 1, qos_override.flow_burst);
+    } else if (key == "flow_controller") {
+      qos_override.flow_controller = value;
+      valid = !value.empty();
+    } else if (key == "batch") {
+      valid = rmw_connextdds_parse_int32(
+        value, 0, qos_override.batch_max_samples);
+    } else if (key == "publish_mode") {
+      qos_override.has_publish_mode = true;
+      qos_override.publish_mode_async = (value == "async");
+      valid = qos_override.publish_mode_async || value == "sync";
+    } else if (key == "reliability") {
+      valid = rmw_connextdds_parse_reliability_preset(
+        value, qos_override.reliability_preset);
+    } else {
+      valid = false;
+    }
+    if (!valid) {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "invalid QoS override in %s: '%s'",
+        entry.source.c_str(), entry.text.c_str())
+      return false;
+    }
+  }
+
+  qos_override.compile();
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "QoS override: pattern=%s, depth=%d, max_samples=%d, batch=%d, "
+    "transport_priority=%d, publish_mode=%s, reliability=%d",
+    qos_override.pattern.c_str(),
+    qos_override.depth,
+    qos_override.max_samples,
+    qos_override.batch_max_samples,
+    qos_override.transport_priority,
+    !qos_override.has_publish_mode ? "default" :
+    (qos_override.publish_mode_async ? "async" : "sync"),
+    qos_override.reliability_preset)
+  return true;
+}
+
+/* Parse an entry of the type bounds table (see
+   rmw_connextdds_get_env_table()). */
+static
+bool
+rmw_connextdds_parse_type_bounds(
+  const RMW_Connext_ConfigEntry & entry,
+  RMW_Connext_TypeBounds & bounds)
+{
+  bounds.pattern = entry.pattern;
+  bool valid = true;
+  for (const auto & setting : entry.settings) {
+    const std::string & key = setting.first;
+    const std::string & value = setting.second;
+
+    if (key == "max_string") {
+      valid = rmw_connextdds_parse_int32(value, 0, bounds.max_string);
+    } else if (key == "max_sequence") {
+      valid = rmw_connextdds_parse_int32(value, 0, bounds.max_sequence);
+    } else {
+      valid = false;
+    }
+    if (!valid) {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "invalid type bounds in %s: '%s'",
+        entry.source.c_str(), entry.text.c_str())
+      return false;
+    }
+  }
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "type bounds: pattern=%s, max_string=%d, max_sequence=%d",
+    bounds.pattern.c_str(),
+    bounds.max_string,
+    bounds.max_sequence)
+  return true;
+}
+
 rmw_ret_t
 rmw_context_impl_t::initialize_node(
   const char * const node_name,
@@ -169,21 +362,145 @@ rmw_context_impl_t::initialize_node(
 
   /* Lookup name of custom QoS library */
   const char * qos_library = nullptr;
-  const char * lookup_rc =
-    rcutils_get_env(RMW_CONNEXT_ENV_QOS_LIBRARY, &qos_library);
-
-  if (nullptr != lookup_rc || nullptr == qos_library) {
-    RMW_CONNEXT_LOG_ERROR_A_SET(
-      "failed to lookup from environment: "
-      "var=%s, "
-      "rc=%s ",
-      RMW_CONNEXT_ENV_QOS_LIBRARY,
-      lookup_rc)
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env(RMW_CONNEXT_ENV_QOS_LIBRARY, &qos_library))
+  {
     return RMW_RET_ERROR;
   }
 
   this->qos_library = qos_library;
 
+  /* Lookup number of threads for parallel deserialization */
+  int64_t deserialize_threads = static_cast<int64_t>(this->deserialize_threads);
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_int64(
+      RMW_CONNEXT_ENV_DESERIALIZE_THREADS, 0, deserialize_threads))
+  {
+    return RMW_RET_ERROR;
+  }
+  this->deserialize_threads = static_cast<size_t>(deserialize_threads);
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "deserialization threads: %lu", this->deserialize_threads)
+
+  /* Lookup default max blocking time for reliable writers */
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_int64(
+      RMW_CONNEXT_ENV_WRITE_BLOCKING_TIME, 0, this->write_blocking_time_ms))
+  {
+    return RMW_RET_ERROR;
+  }
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "writer max blocking time: %ld ms", this->write_blocking_time_ms)
+
+  /* Lookup default timeout of client requests */
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_int64(
+      RMW_CONNEXT_ENV_REQUEST_TIMEOUT, 0, this->request_timeout_ms))
+  {
+    return RMW_RET_ERROR;
+  }
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "client request timeout: %ld ms", this->request_timeout_ms)
+
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_int64(
+      RMW_CONNEXT_ENV_REQUEST_MAX_AGE, 0, this->request_max_age_ms))
+  {
+    return RMW_RET_ERROR;
+  }
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "service request max age: %ld ms", this->request_max_age_ms)
+
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_bool(
+      RMW_CONNEXT_ENV_DISCARD_DEPARTED_REQUESTS,
+      this->discard_departed_requests))
+  {
+    return RMW_RET_ERROR;
+  }
+
+  /* Lookup QoS overrides for the endpoints of topics (or types) matching a
+     pattern, both from the environment (entries separated by ';') and from a
+     file (one entry per line). Entries from the environment take precedence.
+     These also size the sample pools of Micro endpoints (max_samples). */
+  std::vector<RMW_Connext_ConfigEntry> qos_override_entries;
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_table(
+      RMW_CONNEXT_ENV_QOS_OVERRIDES,
+      RMW_CONNEXT_ENV_QOS_OVERRIDES_FILE,
+      qos_override_entries))
+  {
+    return RMW_RET_ERROR;
+  }
+
+  this->qos_overrides.clear();
+  for (const auto & entry : qos_override_entries) {
+    RMW_Connext_QosOverride qos_override;
+    if (!rmw_connextdds_parse_qos_override(entry, qos_override)) {
+      return RMW_RET_ERROR;
+    }
+    this->qos_overrides.push_back(qos_override);
+  }
+
+  /* Lookup the effective bounds of types, both from the environment (entries
+     separated by ';') and from a file (one entry per line). Entries from the
+     environment take precedence. */
+  std::vector<RMW_Connext_ConfigEntry> type_bounds_entries;
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_table(
+      RMW_CONNEXT_ENV_TYPE_BOUNDS,
+      RMW_CONNEXT_ENV_TYPE_BOUNDS_FILE,
+      type_bounds_entries))
+  {
+    return RMW_RET_ERROR;
+  }
+
+  this->type_bounds.clear();
+  for (const auto & entry : type_bounds_entries) {
+    RMW_Connext_TypeBounds bounds;
+    if (!rmw_connextdds_parse_type_bounds(entry, bounds)) {
+      return RMW_RET_ERROR;
+    }
+    this->type_bounds.push_back(bounds);
+  }
+
+  /* Lookup policy used by clients to select a server for each request */
+  static const RMW_Connext_ServerSelection server_selections[] = {
+    RMW_CONNEXT_SERVER_SELECTION_ALL,
+    RMW_CONNEXT_SERVER_SELECTION_ROUND_ROBIN,
+    RMW_CONNEXT_SERVER_SELECTION_LEAST_OUTSTANDING,
+    RMW_CONNEXT_SERVER_SELECTION_AFFINITY,
+  };
+  size_t server_selection = 0;
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_choice(
+      RMW_CONNEXT_ENV_SERVER_SELECTION,
+      {"all", "round-robin", "least-outstanding", "affinity"},
+      server_selection))
+  {
+    return RMW_RET_ERROR;
+  }
+  this->server_selection = server_selections[server_selection];
+
+#if !RMW_CONNEXT_HAVE_REQUEST_TARGET
+  if (RMW_CONNEXT_SERVER_SELECTION_ALL != this->server_selection) {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "server selection not supported by this build, ignoring %s",
+      RMW_CONNEXT_ENV_SERVER_SELECTION)
+    this->server_selection = RMW_CONNEXT_SERVER_SELECTION_ALL;
+  }
+#endif /* !RMW_CONNEXT_HAVE_REQUEST_TARGET */
+
+  /* Lookup scope of DDS publishers and subscribers */
+  size_t pubsub_scope = 0;
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env_choice(
+      RMW_CONNEXT_ENV_PUBSUB_SCOPE, {"context", "node"}, pubsub_scope))
+  {
+    return RMW_RET_ERROR;
+  }
+  this->pubsub_per_node = (1 == pubsub_scope);
+
   if (RMW_RET_OK != rmw_connextdds_initialize_participant_factory(this)) {
     RMW_CONNEXT_LOG_ERROR(
       "failed to initialize DDS DomainParticipantFactory")
@@ -244,71 +561,8 @@ rmw_context_impl_t::initialize_node(
 
   /* Create DDS publisher/subscriber objects that will be used for all DDS writers/readers
       to be created for RMW publishers/subscriptions. */
-
-  DDS_PublisherQos pub_qos = DDS_PublisherQos_INITIALIZER;
-
-  std::unique_ptr<DDS_PublisherQos, std::function<void(DDS_PublisherQos *)>>
-  pub_qos_guard(&pub_qos, &DDS_PublisherQos_finalize);
-  if (nullptr == pub_qos_guard) {
-    this->clean_up();
-    return RMW_RET_ERROR;
-  }
-
-  if (DDS_RETCODE_OK !=
-    DDS_DomainParticipant_get_default_publisher_qos(
-      this->participant, &pub_qos))
-  {
-    RMW_CONNEXT_LOG_ERROR_SET("failed to get default Publisher QoS")
-    this->clean_up();
-    return RMW_RET_ERROR;
-  }
-
-  pub_qos.entity_factory.autoenable_created_entities = DDS_BOOLEAN_FALSE;
-
-  RMW_CONNEXT_LOG_DEBUG("creating default DDS Publisher")
-
-  this->dds_pub = DDS_DomainParticipant_create_publisher(
-    this->participant,
-    &pub_qos,
-    NULL,
-    DDS_STATUS_MASK_NONE);
-
-  if (nullptr == this->dds_pub) {
-    RMW_CONNEXT_LOG_ERROR_SET("failed to create DDS publisher")
-    this->clean_up();
-    return RMW_RET_ERROR;
-  }
-
-  DDS_SubscriberQos sub_qos = DDS_SubscriberQos_INITIALIZER;
-
-  std::unique_ptr<DDS_SubscriberQos, std::function<void(DDS_SubscriberQos *)>>
-  sub_qos_guard(&sub_qos, &DDS_SubscriberQos_finalize);
-  if (nullptr == sub_qos_guard) {
-    this->clean_up();
-    return RMW_RET_ERROR;
-  }
-
-  if (DDS_RETCODE_OK !=
-    DDS_DomainParticipant_get_default_subscriber_qos(
-      this->participant, &sub_qos))
-  {
-    RMW_CONNEXT_LOG_ERROR_SET("failed to get default Subscriber QoS")
-    this->clean_up();
-    return RMW_RET_ERROR;
-  }
-
-  sub_qos.entity_factory.autoenable_created_entities = DDS_BOOLEAN_FALSE;
-
-  RMW_CONNEXT_LOG_DEBUG("creating default DDS Subscriber")
-
-  this->dds_sub = DDS_DomainParticipant_create_subscriber(
-    this->participant,
-    &sub_qos,
-    NULL,
-    DDS_STATUS_MASK_NONE);
-
-  if (nullptr == this->dds_sub) {
-    RMW_CONNEXT_LOG_ERROR_SET("failed to create DDS subscriber")
+  if (RMW_RET_OK != this->create_pubsub(&this->dds_pub, &this->dds_sub)) {
+    RMW_CONNEXT_LOG_ERROR("failed to create default DDS publisher/subscriber")
     this->clean_up();
     return RMW_RET_ERROR;
   }
@@ -319,6 +573,18 @@ rmw_context_impl_t::initialize_node(
     return RMW_RET_ERROR;
   }
 
+  if (this->deserialize_threads > 1) {
+    try {
+      this->deserialize_pool.reset(
+        new RMW_Connext_WorkerPool(this->deserialize_threads - 1));
+    } catch (const std::exception & exc) {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "failed to start deserialization threads: %s", exc.what())
+      this->clean_up();
+      return RMW_RET_ERROR;
+    }
+  }
+
   this->node_count = 1;
 
   if (DDS_RETCODE_OK !=
@@ -362,55 +628,24 @@ rmw_context_impl_t::clean_up(const bool finalize_factory)
 {
   RMW_CONNEXT_LOG_DEBUG("cleaning up RMW context")
 
+  this->deserialize_pool.reset();
+
   if (RMW_RET_OK != rmw_connextdds_graph_finalize(this)) {
     RMW_CONNEXT_LOG_ERROR("failed to finalize graph cache")
     return RMW_RET_ERROR;
   }
 
-  if (nullptr != this->dds_pub) {
-    // If we are cleaning up after some RMW failure, it is possible for some
-    // DataWriter to not have been deleted.
-    // Call DDS_Publisher_delete_contained_entities() to make sure we can
-    // dispose the publisher.
-    if (DDS_RETCODE_OK !=
-      DDS_Publisher_delete_contained_entities(this->dds_pub))
-    {
-      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS publisher's entities")
-      return RMW_RET_ERROR;
-    }
-
-    if (DDS_RETCODE_OK !=
-      DDS_DomainParticipant_delete_publisher(
-        this->participant, this->dds_pub))
-    {
-      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS publisher")
-      return RMW_RET_ERROR;
-    }
-    this->dds_pub = nullptr;
+  if (RMW_RET_OK != this->delete_pubsub(this->dds_pub, nullptr)) {
+    RMW_CONNEXT_LOG_ERROR("failed to delete default DDS publisher")
+    return RMW_RET_ERROR;
   }
+  this->dds_pub = nullptr;
 
-  if (nullptr != this->dds_sub) {
-    // If we are cleaning up after some RMW failure, it is possible for some
-    // DataReader to not have been deleted.
-    // Call DDS_Subscriber_delete_contained_entities() to make sure we can
-    // dispose the publisher.
-    if (DDS_RETCODE_OK !=
-      DDS_Subscriber_delete_contained_entities(this->dds_sub))
-    {
-      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS subscriber's entities")
-      return RMW_RET_ERROR;
-    }
-
-
-    if (DDS_RETCODE_OK !=
-      DDS_DomainParticipant_delete_subscriber(
-        this->participant, this->dds_sub))
-    {
-      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS subscriber")
-      return RMW_RET_ERROR;
-    }
-    this->dds_sub = nullptr;
+  if (RMW_RET_OK != this->delete_pubsub(nullptr, this->dds_sub)) {
+    RMW_CONNEXT_LOG_ERROR("failed to delete default DDS subscriber")
+    return RMW_RET_ERROR;
   }
+  this->dds_sub = nullptr;
 
   if (nullptr != this->participant) {
     // If we are cleaning up after some RMW failure, it is possible for some
@@ -434,6 +669,14 @@ rmw_context_impl_t::clean_up(const bool finalize_factory)
     this->participant = nullptr;
   }
 
+  {
+    std::lock_guard<std::mutex> guard(this->retained_mutex);
+    for (auto type_support : this->retained_type_supports) {
+      delete type_support;
+    }
+    this->retained_type_supports.clear();
+  }
+
   if (finalize_factory && nullptr != this->factory) {
     // If RMW_Connext_gv_DomainParticipantFactory is null, then some other
     // context already finalized the DPF, and we have nothing to do
@@ -467,6 +710,139 @@ rmw_context_impl_t::clean_up(const bool finalize_factory)
   return RMW_RET_OK;
 }
 
+rmw_ret_t
+rmw_context_impl_t::create_pubsub(
+  DDS_Publisher ** const pub_out,
+  DDS_Subscriber ** const sub_out)
+{
+  DDS_PublisherQos pub_qos = DDS_PublisherQos_INITIALIZER;
+
+  std::unique_ptr<DDS_PublisherQos, std::function<void(DDS_PublisherQos *)>>
+  pub_qos_guard(&pub_qos, &DDS_PublisherQos_finalize);
+  if (nullptr == pub_qos_guard) {
+    return RMW_RET_ERROR;
+  }
+
+  if (DDS_RETCODE_OK !=
+    DDS_DomainParticipant_get_default_publisher_qos(
+      this->participant, &pub_qos))
+  {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get default Publisher QoS")
+    return RMW_RET_ERROR;
+  }
+
+  pub_qos.entity_factory.autoenable_created_entities = DDS_BOOLEAN_FALSE;
+
+  RMW_CONNEXT_LOG_DEBUG("creating DDS Publisher")
+
+  DDS_Publisher * const pub = DDS_DomainParticipant_create_publisher(
+    this->participant,
+    &pub_qos,
+    NULL,
+    DDS_STATUS_MASK_NONE);
+
+  if (nullptr == pub) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to create DDS publisher")
+    return RMW_RET_ERROR;
+  }
+
+  auto scope_exit_pub_delete = rcpputils::make_scope_exit(
+    [this, pub]()
+    {
+      if (DDS_RETCODE_OK !=
+        DDS_DomainParticipant_delete_publisher(this->participant, pub))
+      {
+        RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS publisher")
+      }
+    });
+
+  DDS_SubscriberQos sub_qos = DDS_SubscriberQos_INITIALIZER;
+
+  std::unique_ptr<DDS_SubscriberQos, std::function<void(DDS_SubscriberQos *)>>
+  sub_qos_guard(&sub_qos, &DDS_SubscriberQos_finalize);
+  if (nullptr == sub_qos_guard) {
+    return RMW_RET_ERROR;
+  }
+
+  if (DDS_RETCODE_OK !=
+    DDS_DomainParticipant_get_default_subscriber_qos(
+      this->participant, &sub_qos))
+  {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get default Subscriber QoS")
+    return RMW_RET_ERROR;
+  }
+
+  sub_qos.entity_factory.autoenable_created_entities = DDS_BOOLEAN_FALSE;
+
+  RMW_CONNEXT_LOG_DEBUG("creating DDS Subscriber")
+
+  DDS_Subscriber * const sub = DDS_DomainParticipant_create_subscriber(
+    this->participant,
+    &sub_qos,
+    NULL,
+    DDS_STATUS_MASK_NONE);
+
+  if (nullptr == sub) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to create DDS subscriber")
+    return RMW_RET_ERROR;
+  }
+
+  scope_exit_pub_delete.cancel();
+
+  *pub_out = pub;
+  *sub_out = sub;
+
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_context_impl_t::delete_pubsub(
+  DDS_Publisher * const pub,
+  DDS_Subscriber * const sub)
+{
+  if (nullptr != pub) {
+    // If we are cleaning up after some RMW failure, it is possible for some
+    // DataWriter to not have been deleted.
+    // Call DDS_Publisher_delete_contained_entities() to make sure we can
+    // dispose the publisher.
+    if (DDS_RETCODE_OK !=
+      DDS_Publisher_delete_contained_entities(pub))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS publisher's entities")
+      return RMW_RET_ERROR;
+    }
+
+    if (DDS_RETCODE_OK !=
+      DDS_DomainParticipant_delete_publisher(this->participant, pub))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS publisher")
+      return RMW_RET_ERROR;
+    }
+  }
+
+  if (nullptr != sub) {
+    // If we are cleaning up after some RMW failure, it is possible for some
+    // DataReader to not have been deleted.
+    // Call DDS_Subscriber_delete_contained_entities() to make sure we can
+    // dispose the subscriber.
+    if (DDS_RETCODE_OK !=
+      DDS_Subscriber_delete_contained_entities(sub))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS subscriber's entities")
+      return RMW_RET_ERROR;
+    }
+
+    if (DDS_RETCODE_OK !=
+      DDS_DomainParticipant_delete_subscriber(this->participant, sub))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to delete DDS subscriber")
+      return RMW_RET_ERROR;
+    }
+  }
+
+  return RMW_RET_OK;
+}
+
 rmw_ret_t
 rmw_context_impl_t::finalize_node()
 {
@@ -488,6 +864,31 @@ rmw_context_impl_t::finalize_node()
   return this->clean_up(false /* finalize_factory */);
 }
 
+rmw_ret_t
+rmw_context_impl_t::retain_type_support(
+  RMW_Connext_MessageTypeSupport * const type_support)
+{
+  std::lock_guard<std::mutex> guard(this->retained_mutex);
+  try {
+    this->retained_type_supports.push_back(type_support);
+  } catch (const std::exception & exc) {
+    RMW_CONNEXT_LOG_ERROR_A_SET("failed to retain type support: %s", exc.what())
+    return RMW_RET_ERROR;
+  }
+  return RMW_RET_OK;
+}
+
+bool
+rmw_context_impl_t::is_context_shutdown(rmw_context_t * const context)
+{
+  if (this->share_key.empty()) {
+    return this->is_shutdown;
+  }
+  std::lock_guard<std::mutex> guard(RMW_Connext_gv_SharedContextsMutex);
+  auto it = this->shared_contexts.find(context);
+  return it == this->shared_contexts.end() || it->second;
+}
+
 uint32_t
 rmw_context_impl_t::next_client_id()
 {
@@ -768,6 +1169,32 @@ rmw_api_connextdds_init(
 
 #endif /* RMW_CONNEXT_HAVE_OPTIONS*/
 
+  std::string share_key;
+  ret = rmw_connextdds_get_context_share_key(context, actual_domain_id, share_key);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+
+  std::unique_lock<std::mutex> share_lock(
+    RMW_Connext_gv_SharedContextsMutex, std::defer_lock);
+  if (!share_key.empty()) {
+    share_lock.lock();
+    // Implementations are removed from the pool once all of their attached
+    // contexts have been shut down, so the one found here is still running.
+    auto it = RMW_Connext_gv_SharedContexts.find(share_key);
+    if (it != RMW_Connext_gv_SharedContexts.end()) {
+      RMW_CONNEXT_LOG_DEBUG_A(
+        "attaching to shared context: key=%s", share_key.c_str())
+      context->impl = it->second;
+      context->impl->shared_contexts[context] = false;
+#if RMW_CONNEXT_HAVE_OPTIONS
+      scope_exit_context_finalize.cancel();
+#endif /* RMW_CONNEXT_HAVE_OPTIONS */
+      scope_exit_context_reset.cancel();
+      return RMW_RET_OK;
+    }
+  }
+
   /* The context object will be initialized upon creation of the first node */
   context->impl = new (std::nothrow) rmw_context_impl_t(context);
   if (nullptr == context->impl) {
@@ -779,6 +1206,12 @@ rmw_api_connextdds_init(
   // context->actual_domain_id in rmw_context_impl_t::initialize_node()
   context->impl->domain_id = actual_domain_id;
 
+  if (!share_key.empty()) {
+    context->impl->share_key = share_key;
+    context->impl->shared_contexts[context] = false;
+    RMW_Connext_gv_SharedContexts[share_key] = context->impl;
+  }
+
 #if RMW_CONNEXT_HAVE_OPTIONS
   scope_exit_context_finalize.cancel();
 #endif /* RMW_CONNEXT_HAVE_OPTIONS */
@@ -801,7 +1234,29 @@ rmw_api_connextdds_shutdown(rmw_context_t * context)
     RMW_CONNEXTDDS_ID,
     return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
-  context->impl->is_shutdown = true;
+  rmw_context_impl_t * const ctx = context->impl;
+  if (ctx->share_key.empty()) {
+    ctx->is_shutdown = true;
+    return RMW_RET_OK;
+  }
+
+  // A shared implementation is only marked as shut down once all the
+  // contexts attached to it have been shut down. At that point it is also
+  // removed from the pool, so that contexts initialized afterwards (while
+  // the shut down ones are yet to be finalized) create a new one.
+  std::lock_guard<std::mutex> guard(RMW_Connext_gv_SharedContextsMutex);
+  ctx->shared_contexts[context] = true;
+  bool all_shutdown = true;
+  for (const auto & attached : ctx->shared_contexts) {
+    all_shutdown = all_shutdown && attached.second;
+  }
+  if (all_shutdown) {
+    auto it = RMW_Connext_gv_SharedContexts.find(ctx->share_key);
+    if (it != RMW_Connext_gv_SharedContexts.end() && it->second == ctx) {
+      RMW_Connext_gv_SharedContexts.erase(it);
+    }
+  }
+  ctx->is_shutdown = all_shutdown;
   return RMW_RET_OK;
 }
 
@@ -820,23 +1275,53 @@ rmw_api_connextdds_context_fini(rmw_context_t * context)
     RMW_CONNEXTDDS_ID,
     return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
-  if (!context->impl->is_shutdown) {
+  rmw_context_impl_t * const ctx = context->impl;
+
+  if (!ctx->is_context_shutdown(context)) {
     RMW_CONNEXT_LOG_ERROR_SET("context has not been shutdown")
     return RMW_RET_INVALID_ARGUMENT;
   }
 
-  if (0u != context->impl->node_count) {
-    RMW_CONNEXT_LOG_ERROR_A(
-      "not all nodes finalized: %lu", context->impl->node_count)
+  // A shared implementation is only finalized by the last context attached
+  // to it. Other contexts simply detach from it.
+  bool detach_only = false;
+  if (!ctx->share_key.empty()) {
+    std::lock_guard<std::mutex> guard(RMW_Connext_gv_SharedContextsMutex);
+    ctx->shared_contexts.erase(context);
+    if (ctx->shared_contexts.empty()) {
+      // The implementation was removed from the pool when its last attached
+      // context was shut down (unless a new one already replaced it).
+      auto it = RMW_Connext_gv_SharedContexts.find(ctx->share_key);
+      if (it != RMW_Connext_gv_SharedContexts.end() && it->second == ctx) {
+        RMW_Connext_gv_SharedContexts.erase(it);
+      }
+    } else {
+      std::lock_guard<std::mutex> init_guard(ctx->initialization_mutex);
+      if (ctx->base == context) {
+        // all attached contexts have the same options
+        ctx->base = ctx->shared_contexts.begin()->first;
+      }
+      detach_only = true;
+      RMW_CONNEXT_LOG_DEBUG_A(
+        "detached from shared context: key=%s, remaining=%lu",
+        ctx->share_key.c_str(), ctx->shared_contexts.size())
+    }
   }
 
-  // TODO(asorbini) keep track of created GuardConditions/WaitSets and make
-  // sure that all of them have been cleaned up.
+  if (!detach_only) {
+    if (0u != ctx->node_count) {
+      RMW_CONNEXT_LOG_ERROR_A(
+        "not all nodes finalized: %lu", ctx->node_count)
+    }
 
-  rmw_ret_t rc = context->impl->clean_up();
-  if (RMW_RET_OK != rc) {
-    RMW_CONNEXT_LOG_ERROR("failed to finalize DDS participant factory")
-    return rc;
+    // TODO(asorbini) keep track of created GuardConditions/WaitSets and make
+    // sure that all of them have been cleaned up.
+
+    rmw_ret_t rc = ctx->clean_up();
+    if (RMW_RET_OK != rc) {
+      RMW_CONNEXT_LOG_ERROR("failed to finalize DDS participant factory")
+      return rc;
+    }
   }
 
 #if RMW_CONNEXT_HAVE_OPTIONS
@@ -845,7 +1330,9 @@ rmw_api_connextdds_context_fini(rmw_context_t * context)
     return ret;
   }
 #endif /* RMW_CONNEXT_HAVE_OPTIONS */
-  delete context->impl;
+  if (!detach_only) {
+    delete ctx;
+  }
   *context = rmw_get_zero_initialized_context();
   return RMW_RET_OK;
 }
@@ -856,7 +1343,9 @@ rmw_connextdds_configure_security(
   DDS_DomainParticipantQos * const qos)
 {
 #if RMW_CONNEXT_HAVE_SECURITY
-  if (nullptr == ctx->base->options.security_options.security_root_path) {
+  const char * const security_root_path =
+    ctx->base.load()->options.security_options.security_root_path;
+  if (nullptr == security_root_path) {
     // Security not enabled;
     return RMW_RET_OK;
   }
@@ -879,7 +1368,7 @@ rmw_connextdds_configure_security(
 
   char * const prop_identity_ca =
     rcutils_join_path(
-    ctx->base->options.security_options.security_root_path,
+    security_root_path,
     "identity_ca.cert.pem",
     allocator);
   auto scope_exit_prop_identity_ca = rcpputils::make_scope_exit(
@@ -903,7 +1392,7 @@ rmw_connextdds_configure_security(
 
   char * const prop_perm_ca =
     rcutils_join_path(
-    ctx->base->options.security_options.security_root_path,
+    security_root_path,
     "permissions_ca.cert.pem",
     allocator);
   auto scope_exit_prop_perm_ca = rcpputils::make_scope_exit(
@@ -927,7 +1416,7 @@ rmw_connextdds_configure_security(
 
   char * const prop_peer_key =
     rcutils_join_path(
-    ctx->base->options.security_options.security_root_path,
+    security_root_path,
     "key.pem",
     allocator);
   auto scope_exit_prop_peer_key = rcpputils::make_scope_exit(
@@ -951,7 +1440,7 @@ rmw_connextdds_configure_security(
 
   char * const prop_peer_cert =
     rcutils_join_path(
-    ctx->base->options.security_options.security_root_path,
+    security_root_path,
     "cert.pem",
     allocator);
   auto scope_exit_prop_peer_cert = rcpputils::make_scope_exit(
@@ -976,7 +1465,7 @@ rmw_connextdds_configure_security(
 
   char * const prop_governance =
     rcutils_join_path(
-    ctx->base->options.security_options.security_root_path,
+    security_root_path,
     "governance.p7s",
     allocator);
   auto scope_exit_prop_governance = rcpputils::make_scope_exit(
@@ -1001,7 +1490,7 @@ rmw_connextdds_configure_security(
 
   char * const prop_permissions =
     rcutils_join_path(
-    ctx->base->options.security_options.security_root_path,
+    security_root_path,
     "permissions.p7s",
     allocator);
   auto scope_exit_prop_permissions = rcpputils::make_scope_exit(
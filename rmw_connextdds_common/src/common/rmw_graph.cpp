@@ -161,7 +161,7 @@ rmw_connextdds_graph_initialize(rmw_context_impl_t * const ctx)
   std::string dp_enclave;
 
 #if RMW_CONNEXT_HAVE_OPTIONS
-  dp_enclave = ctx->base->options.enclave;
+  dp_enclave = ctx->base.load()->options.enclave;
 #endif /* RMW_CONNEXT_HAVE_OPTIONS*/
 
   ctx->common.graph_cache.add_participant(ctx->common.gid, dp_enclave);
@@ -281,6 +281,13 @@ rmw_connextdds_graph_publish_update(
     return RMW_RET_OK;
   }
 
+  if (ctx->is_shutdown) {
+    // Remote participants will purge all of the participant's entities once
+    // it is deleted, so there is no need to announce each individual update.
+    RMW_CONNEXT_LOG_DEBUG("context shut down, graph update not published")
+    return RMW_RET_OK;
+  }
+
   if (RMW_RET_OK != rmw_publish(ctx->common.pub, msg, nullptr)) {
     RMW_CONNEXT_LOG_ERROR("failed to publish discovery sample")
     return RMW_RET_ERROR;
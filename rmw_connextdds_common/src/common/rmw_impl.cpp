@@ -15,6 +15,8 @@
 #include "rmw_connextdds/rmw_impl.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -73,6 +75,211 @@ rmw_connextdds_create_topic_name(
     qos_policies->avoid_ros_namespace_conventions);
 }
 
+bool
+rmw_connextdds_match_pattern(
+  const char * const pattern,
+  const char * const name)
+{
+  // Iterative glob matching, backtracking to the last '*' on mismatch.
+  const char * p = pattern;
+  const char * n = name;
+  const char * star_p = nullptr;
+  const char * star_n = nullptr;
+
+  while ('\0' != *n) {
+    if ('*' == *p) {
+      star_p = p++;
+      star_n = n;
+    } else if ('?' == *p || *p == *n) {
+      p++;
+      n++;
+    } else if (nullptr != star_p) {
+      p = star_p + 1;
+      n = ++star_n;
+    } else {
+      return false;
+    }
+  }
+
+  while ('*' == *p) {
+    p++;
+  }
+
+  return '\0' == *p;
+}
+
+void
+RMW_Connext_QosOverride::compile()
+{
+  const size_t wildcard = this->pattern.find_first_of("*?");
+  if (std::string::npos == wildcard) {
+    this->match_kind = MATCH_EXACT;
+  } else if (wildcard == this->pattern.length() - 1 &&
+    '*' == this->pattern[wildcard])
+  {
+    this->match_kind = MATCH_PREFIX;
+  } else {
+    this->match_kind = MATCH_GLOB;
+  }
+}
+
+bool
+RMW_Connext_QosOverride::matches(const char * const topic_name) const
+{
+  switch (this->match_kind) {
+    case MATCH_EXACT:
+      {
+        return this->pattern == topic_name;
+      }
+    case MATCH_PREFIX:
+      {
+        return strncmp(
+          this->pattern.c_str(), topic_name, this->pattern.length() - 1) == 0;
+      }
+    default:
+      {
+        return rmw_connextdds_match_pattern(this->pattern.c_str(), topic_name);
+      }
+  }
+}
+
+const RMW_Connext_QosOverride *
+rmw_connextdds_find_qos_override(
+  rmw_context_impl_t * const ctx,
+  const char * const topic_name,
+  const char * const type_name)
+{
+  for (const auto & qos_override : ctx->qos_overrides) {
+    if (qos_override.matches(topic_name) || qos_override.matches(type_name)) {
+      RMW_CONNEXT_LOG_DEBUG_A(
+        "QoS override: topic=%s, type=%s, pattern=%s",
+        topic_name, type_name, qos_override.pattern.c_str())
+      return &qos_override;
+    }
+  }
+  return nullptr;
+}
+
+bool
+rmw_connextdds_get_reliability_preset(
+  const RMW_Connext_QosOverride::ReliabilityPreset preset,
+  RMW_Connext_ReliabilityProtocol * const protocol)
+{
+  switch (preset) {
+    case RMW_Connext_QosOverride::RELIABILITY_PRESET_LOW_LATENCY:
+      {
+        // Small, frequent messages: piggyback a heartbeat every few samples
+        // and repair immediately, without throttling the writer.
+        protocol->heartbeat_period_ms = 100;
+        protocol->fast_heartbeat_period_ms = 10;
+        protocol->nack_response_delay_ms = 0;
+        protocol->heartbeats_per_max_samples = 8;
+        protocol->send_window_min = 0;
+        protocol->send_window_max = 0;
+        protocol->heartbeat_response_delay_ms = 0;
+        protocol->nack_period_ms = 10;
+        return true;
+      }
+    case RMW_Connext_QosOverride::RELIABILITY_PRESET_BULK:
+      {
+        // Large messages: bound the number of unacknowledged samples so that
+        // repairs of lost fragments are not starved by new data, and let
+        // NACKs from multiple readers be coalesced.
+        protocol->heartbeat_period_ms = 200;
+        protocol->fast_heartbeat_period_ms = 20;
+        protocol->nack_response_delay_ms = 5;
+        protocol->heartbeats_per_max_samples = 32;
+        protocol->send_window_min = 8;
+        protocol->send_window_max = 64;
+        protocol->heartbeat_response_delay_ms = 5;
+        protocol->nack_period_ms = 50;
+        return true;
+      }
+    case RMW_Connext_QosOverride::RELIABILITY_PRESET_LOSSY_LINK:
+      {
+        // Frequent losses: detect them quickly and keep the send window
+        // small, so that the writer backs off while readers are behind.
+        protocol->heartbeat_period_ms = 50;
+        protocol->fast_heartbeat_period_ms = 5;
+        protocol->nack_response_delay_ms = 0;
+        protocol->heartbeats_per_max_samples = 64;
+        protocol->send_window_min = 4;
+        protocol->send_window_max = 32;
+        protocol->heartbeat_response_delay_ms = 0;
+        protocol->nack_period_ms = 5;
+        return true;
+      }
+    default:
+      {
+        return false;
+      }
+  }
+}
+
+bool
+rmw_connextdds_request_target_matches(
+  const rcutils_uint8_array_t * const data_buffer,
+  const rmw_gid_t * const reader_gid)
+{
+#if RMW_CONNEXT_HAVE_REQUEST_TARGET
+  // The target follows the requester's GID and the request's SN in the
+  // request header (see RMW_Connext_MessageTypeSupport::serialize()).
+  const size_t target_offset =
+    RMW_Connext_MessageTypeSupport::ENCAPSULATION_HEADER_SIZE +
+    RMW_GID_STORAGE_SIZE + sizeof(int64_t);
+  if (data_buffer->buffer_length < target_offset + RMW_GID_STORAGE_SIZE) {
+    return false;
+  }
+
+  const uint8_t * const target = data_buffer->buffer + target_offset;
+  bool any_server = true;
+  for (size_t i = 0; i < RMW_GID_STORAGE_SIZE && any_server; i++) {
+    any_server = (0 == target[i]);
+  }
+
+  return any_server ||
+         memcmp(target, reader_gid->data, RMW_GID_STORAGE_SIZE) == 0;
+#else
+  UNUSED_ARG(data_buffer);
+  UNUSED_ARG(reader_gid);
+  return true;
+#endif /* RMW_CONNEXT_HAVE_REQUEST_TARGET */
+}
+
+rmw_ret_t
+rmw_connextdds_parse_related_writer_filter(
+  const char * const filter,
+  DDS_GUID_t * const writer_guid)
+{
+  // Only expressions in the form generated by rmw_connextdds_create_client()
+  // are supported, i.e. "<field> = &hex(<32 hex digits>)".
+  static const char * const FILTER_PREFIX =
+    "@related_sample_identity.writer_guid.value = &hex(";
+  const size_t prefix_len = strlen(FILTER_PREFIX);
+
+  if (nullptr == filter || 0 != strncmp(filter, FILTER_PREFIX, prefix_len)) {
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  const char * hex = filter + prefix_len;
+  for (size_t i = 0; i < sizeof(writer_guid->value); i++, hex += 2) {
+    unsigned int octet = 0;
+    if (!isxdigit(static_cast<unsigned char>(hex[0])) ||
+      !isxdigit(static_cast<unsigned char>(hex[1])) ||
+      1 != sscanf(hex, "%2x", &octet))
+    {
+      return RMW_RET_UNSUPPORTED;
+    }
+    writer_guid->value[i] = static_cast<DDS_Octet>(octet);
+  }
+
+  if (0 != strcmp(hex, ")")) {
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  return RMW_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_uint8_array_copy(
   rcutils_uint8_array_t * const dst,
@@ -137,6 +344,7 @@ rmw_connextdds_get_readerwriter_qos(
 #if RMW_CONNEXT_HAVE_LIFESPAN_QOS
   DDS_LifespanQosPolicy * const lifespan,
 #endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS */
+  const RMW_Connext_QosOverride * const qos_override,
   const rmw_qos_profile_t * const qos_policies
 #if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
   ,
@@ -147,7 +355,6 @@ rmw_connextdds_get_readerwriter_qos(
 {
   UNUSED_ARG(writer_qos);
   UNUSED_ARG(type_support);
-  UNUSED_ARG(publish_mode);
 #if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
   UNUSED_ARG(pub_options);
   UNUSED_ARG(sub_options);
@@ -189,6 +396,12 @@ rmw_connextdds_get_readerwriter_qos(
       }
   }
 
+  if (nullptr != qos_override && qos_override->depth > 0 &&
+    history->kind == DDS_KEEP_LAST_HISTORY_QOS)
+  {
+    history->depth = qos_override->depth;
+  }
+
   RMW_CONNEXT_LOG_DEBUG_A(
     "endpoint resource history: "
     "kind=%d, "
@@ -296,11 +509,20 @@ rmw_connextdds_get_readerwriter_qos(
     lifespan->duration.nanosec =
       static_cast<DDS_UnsignedLong>(qos_policies->lifespan.nsec);
 #else
-    RMW_CONNEXT_LOG_WARNING("lifespan qos policy not supported")
+    RMW_CONNEXT_LOG_WARNING(
+      "lifespan qos policy not supported by publishers, "
+      "it is only enforced by subscriptions")
 #endif /* RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO */
   }
 #endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS */
 
+  if (nullptr != publish_mode &&
+    nullptr != qos_override && qos_override->has_publish_mode)
+  {
+    publish_mode->kind = qos_override->publish_mode_async ?
+      DDS_ASYNCHRONOUS_PUBLISH_MODE_QOS : DDS_SYNCHRONOUS_PUBLISH_MODE_QOS;
+  }
+
   // Make sure that resource limits are consistent with history qos
   // TODO(asorbini): do not overwrite if using non-default QoS
   if (history->kind == DDS_KEEP_LAST_HISTORY_QOS &&
@@ -316,9 +538,103 @@ rmw_connextdds_get_readerwriter_qos(
     }
   }
 
+  if (nullptr != qos_override && qos_override->max_samples > 0) {
+    // Never allocate less samples than required by the history depth
+    DDS_Long max_samples = qos_override->max_samples;
+    if (history->kind == DDS_KEEP_LAST_HISTORY_QOS &&
+      history->depth > max_samples)
+    {
+      max_samples = history->depth;
+    }
+    resource_limits->max_samples = max_samples;
+    resource_limits->max_samples_per_instance = max_samples;
+  }
+
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_get_writer_blocking_qos(
+  rmw_context_impl_t * const ctx,
+  DDS_ReliabilityQosPolicy * const reliability
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  ,
+  const rmw_publisher_options_t * const pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+)
+{
+  if (ctx->write_blocking_time_ms >= 0) {
+    rmw_connextdds_duration_from_ms(
+      ctx->write_blocking_time_ms, &reliability->max_blocking_time);
+  }
+
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  if (nullptr == pub_options ||
+    nullptr == pub_options->rmw_specific_publisher_payload)
+  {
+    return RMW_RET_OK;
+  }
+
+  const rmw_connextdds_publisher_options_t * const opts =
+    static_cast<const rmw_connextdds_publisher_options_t *>(
+    pub_options->rmw_specific_publisher_payload);
+
+  if (opts->try_publish) {
+    reliability->max_blocking_time.sec = 0;
+    reliability->max_blocking_time.nanosec = 0;
+  } else if (opts->max_blocking_time.sec != 0 ||
+    opts->max_blocking_time.nsec != 0)
+  {
+    if (opts->max_blocking_time.sec > INT32_MAX ||
+      opts->max_blocking_time.nsec >= 1000000000)
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("invalid max blocking time for publisher")
+      return RMW_RET_INVALID_ARGUMENT;
+    }
+    reliability->max_blocking_time.sec =
+      static_cast<DDS_Long>(opts->max_blocking_time.sec);
+    reliability->max_blocking_time.nanosec =
+      static_cast<DDS_UnsignedLong>(opts->max_blocking_time.nsec);
+  }
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "writer max blocking time: sec=%d, nanosec=%u",
+    reliability->max_blocking_time.sec,
+    reliability->max_blocking_time.nanosec)
+
   return RMW_RET_OK;
 }
 
+int32_t
+rmw_connextdds_get_writer_transport_priority(
+  const RMW_Connext_QosOverride * const qos_override
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  ,
+  const rmw_publisher_options_t * const pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+)
+{
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  if (nullptr != pub_options &&
+    nullptr != pub_options->rmw_specific_publisher_payload)
+  {
+    const rmw_connextdds_publisher_options_t * const opts =
+      static_cast<const rmw_connextdds_publisher_options_t *>(
+      pub_options->rmw_specific_publisher_payload);
+    if (0 != opts->transport_priority) {
+      return opts->transport_priority;
+    }
+  }
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+
+  if (nullptr != qos_override && qos_override->transport_priority >= 0) {
+    return qos_override->transport_priority;
+  }
+
+  return 0;
+}
+
 rmw_ret_t
 rmw_connextdds_readerwriter_qos_to_ros(
   const DDS_HistoryQosPolicy * const history,
@@ -1110,12 +1426,83 @@ RMW_Connext_Node::create(
     return nullptr;
   }
 
+  auto scope_exit_node_impl_delete = rcpputils::make_scope_exit(
+    [node_impl]()
+    {
+      if (RMW_RET_OK != node_impl->finalize()) {
+        RMW_CONNEXT_LOG_ERROR("failed to finalize node implementation")
+      }
+      delete node_impl;
+    });
+
+  if (ctx->pubsub_per_node) {
+    if (RMW_RET_OK !=
+      ctx->create_pubsub(&node_impl->dds_pub, &node_impl->dds_sub))
+    {
+      RMW_CONNEXT_LOG_ERROR("failed to create node's DDS publisher/subscriber")
+      return nullptr;
+    }
+
+    if (DDS_RETCODE_OK !=
+      DDS_Entity_enable(DDS_Subscriber_as_entity(node_impl->dds_sub)))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to enable node's dds subscriber")
+      return nullptr;
+    }
+
+    if (DDS_RETCODE_OK !=
+      DDS_Entity_enable(DDS_Publisher_as_entity(node_impl->dds_pub)))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to enable node's dds publisher")
+      return nullptr;
+    }
+  }
+
+  scope_exit_node_impl_delete.cancel();
   return node_impl;
 }
 
 rmw_ret_t
 RMW_Connext_Node::finalize()
 {
+  if (this->ctx->fast_teardown()) {
+    // the node's publisher and subscriber will be deleted with the participant
+    this->dds_pub = nullptr;
+    this->dds_sub = nullptr;
+    return RMW_RET_OK;
+  }
+  // The node's publisher and subscriber are only deleted once they no longer
+  // contain any endpoint, since the endpoints are still referenced by the
+  // publishers, subscriptions, clients, and services created from the node.
+  if (nullptr != this->dds_pub) {
+    const DDS_ReturnCode_t rc =
+      DDS_DomainParticipant_delete_publisher(
+      this->ctx->participant, this->dds_pub);
+    if (DDS_RETCODE_PRECONDITION_NOT_MET == rc) {
+      RMW_CONNEXT_LOG_ERROR_SET(
+        "cannot finalize node with existing publishers, clients, or services")
+      return RMW_RET_ERROR;
+    } else if (DDS_RETCODE_OK != rc) {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to delete node's DDS publisher")
+      return RMW_RET_ERROR;
+    }
+    this->dds_pub = nullptr;
+  }
+  if (nullptr != this->dds_sub) {
+    const DDS_ReturnCode_t rc =
+      DDS_DomainParticipant_delete_subscriber(
+      this->ctx->participant, this->dds_sub);
+    if (DDS_RETCODE_PRECONDITION_NOT_MET == rc) {
+      RMW_CONNEXT_LOG_ERROR_SET(
+        "cannot finalize node with existing subscriptions, clients, "
+        "or services")
+      return RMW_RET_ERROR;
+    } else if (DDS_RETCODE_OK != rc) {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to delete node's DDS subscriber")
+      return RMW_RET_ERROR;
+    }
+    this->dds_sub = nullptr;
+  }
   return RMW_RET_OK;
 }
 
@@ -1132,7 +1519,8 @@ RMW_Connext_Publisher::RMW_Connext_Publisher(
   dds_writer(dds_writer),
   type_support(type_support),
   created_topic(created_topic),
-  status_condition(dds_writer)
+  status_condition(dds_writer),
+  write_timeouts_count(0)
 {
   rmw_connextdds_get_entity_gid(this->dds_writer, this->ros_gid);
 }
@@ -1326,6 +1714,23 @@ RMW_Connext_Publisher::finalize()
   // Make sure publisher's condition is detached from any waitset
   this->status_condition.invalidate();
 
+  if (this->ctx->fast_teardown()) {
+    // The DataWriter, its Topic, and the registered type will be deleted
+    // together with the DomainParticipant. The type support is referenced
+    // by the registered type plugin, so it must outlive them.
+    rmw_ret_t rc = RMW_Connext_MessageTypeSupport::unregister_type_support(
+      this->ctx, this->dds_participant(), this->type_support->type_name(),
+      true /* keep_registered */);
+    if (RMW_RET_OK != rc) {
+      return rc;
+    }
+    if (RMW_RET_OK != this->ctx->retain_type_support(this->type_support)) {
+      return RMW_RET_ERROR;
+    }
+    this->type_support = nullptr;
+    return RMW_RET_OK;
+  }
+
   if (DDS_RETCODE_OK !=
     DDS_Publisher_delete_datawriter(
       this->dds_publisher(), this->dds_writer))
@@ -1410,7 +1815,19 @@ RMW_Connext_Publisher::write(
   user_msg.serialized = serialized;
   user_msg.type_support = this->type_support;
 
-  return rmw_connextdds_write_message(this, &user_msg, sn_out);
+  rmw_ret_t rc = rmw_connextdds_write_message(this, &user_msg, sn_out);
+  if (RMW_RET_TIMEOUT == rc) {
+    this->write_timeouts_count += 1;
+#if !RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT
+    rmw_reset_error();
+    RMW_CONNEXT_LOG_ERROR_A_SET(
+      "write timed out, max blocking time expired: topic=%s",
+      DDS_TopicDescription_get_name(
+        DDS_Topic_as_topicdescription(this->dds_topic())))
+    rc = RMW_RET_ERROR;
+#endif /* !RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT */
+  }
+  return rc;
 }
 
 
@@ -1432,6 +1849,41 @@ RMW_Connext_Publisher::subscriptions_count()
   return status.current_count;
 }
 
+static
+void
+rmw_connextdds_handles_to_gids(
+  DDS_InstanceHandleSeq * const handles,
+  std::vector<rmw_gid_t> & gids)
+{
+  const DDS_Long handles_len = DDS_InstanceHandleSeq_get_length(handles);
+  gids.resize(static_cast<size_t>(handles_len));
+  for (DDS_Long i = 0; i < handles_len; i++) {
+    rmw_connextdds_ih_to_gid(
+      *DDS_InstanceHandleSeq_get_reference(handles, i), gids[i]);
+  }
+}
+
+rmw_ret_t
+RMW_Connext_Publisher::matched_subscriptions(std::vector<rmw_gid_t> & gids)
+{
+  DDS_InstanceHandleSeq handles = DDS_SEQUENCE_INITIALIZER;
+  auto scope_exit_handles = rcpputils::make_scope_exit(
+    [&handles]()
+    {
+      DDS_InstanceHandleSeq_finalize(&handles);
+    });
+
+  if (DDS_RETCODE_OK !=
+    DDS_DataWriter_get_matched_subscriptions(this->dds_writer, &handles))
+  {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get matched subscriptions")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_connextdds_handles_to_gids(&handles, gids);
+  return RMW_RET_OK;
+}
+
 rmw_ret_t
 RMW_Connext_Publisher::assert_liveliness()
 {
@@ -1616,7 +2068,9 @@ RMW_Connext_Subscriber::RMW_Connext_Subscriber(
   const bool ignore_local,
   const bool created_topic,
   DDS_TopicDescription * const dds_topic_cft,
-  const bool internal)
+  const bool internal,
+  const int64_t lifespan_ns,
+  const DDS_GUID_t * const related_writer_filter)
 : internal(internal),
   ctx(ctx),
   dds_reader(dds_reader),
@@ -1624,17 +2078,30 @@ RMW_Connext_Subscriber::RMW_Connext_Subscriber(
   dds_topic_cft(dds_topic_cft),
   type_support(type_support),
   created_topic(created_topic),
-  status_condition(dds_reader, ignore_local)
+  status_condition(
+    dds_reader, ignore_local, lifespan_ns, related_writer_filter,
+    RMW_CONNEXT_HAVE_REQUEST_TARGET && type_support->type_request())
 {
   rmw_connextdds_get_entity_gid(this->dds_reader, this->ros_gid);
+  if (this->status_condition.filter_request_target) {
+    // The reader is still disabled, so no sample can be filtered yet.
+    this->status_condition.request_target_gid = this->ros_gid;
+  }
 
   RMW_Connext_UntypedSampleSeq def_data_seq =
     RMW_Connext_UntypedSampleSeq_INITIALIZER;
   DDS_SampleInfoSeq def_info_seq = DDS_SEQUENCE_INITIALIZER;
-  this->loan_data = def_data_seq;
-  this->loan_info = def_info_seq;
-  this->loan_len = 0;
-  this->loan_next = 0;
+  for (size_t i = 0; i < RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX; i++) {
+    this->loans[i].data = def_data_seq;
+    this->loans[i].info = def_info_seq;
+    this->loans[i].len = 0;
+    this->loans[i].next = 0;
+  }
+  this->loan_head = 0;
+  this->loan_count = 0;
+  this->info_fields = RMW_CONNEXT_MESSAGE_INFO_ALL;
+  this->order_by_priority =
+    RMW_CONNEXT_HAVE_REQUEST_PRIORITY && type_support->type_request();
 }
 
 RMW_Connext_Subscriber *
@@ -1748,6 +2215,8 @@ RMW_Connext_Subscriber::create(
     });
 
   DDS_TopicDescription * sub_topic = DDS_Topic_as_topicdescription(topic);
+  DDS_GUID_t related_writer_guid;
+  const DDS_GUID_t * related_writer_filter = nullptr;
 
   if (nullptr != cft_name) {
     rmw_ret_t cft_rc =
@@ -1758,6 +2227,22 @@ RMW_Connext_Subscriber::create(
       if (RMW_RET_UNSUPPORTED != cft_rc) {
         return nullptr;
       }
+#if RMW_CONNEXT_EMULATE_REQUESTREPLY
+      // Evaluate the filter on the reader side instead, using the request
+      // header included in each sample's payload.
+      if (RMW_RET_OK ==
+        rmw_connextdds_parse_related_writer_filter(
+          cft_filter, &related_writer_guid))
+      {
+        related_writer_filter = &related_writer_guid;
+      }
+#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
+      if (nullptr == related_writer_filter) {
+        // Don't silently deliver the samples that the filter would reject
+        RMW_CONNEXT_LOG_ERROR_A_SET(
+          "content filter not supported: %s", cft_filter)
+        return nullptr;
+      }
     } else {
       sub_topic = cft_topic;
     }
@@ -1822,6 +2307,19 @@ RMW_Connext_Subscriber::create(
       }
     });
 
+  int64_t lifespan_ns = 0;
+#if RMW_CONNEXT_HAVE_LIFESPAN_QOS && \
+  RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_MICRO
+  // Micro doesn't support DDS_LifespanQosPolicy, so emulate it on the reader
+  // side, by dropping samples older than the subscription's lifespan.
+  if (qos_policies->lifespan.sec != 0 || qos_policies->lifespan.nsec != 0) {
+    lifespan_ns =
+      static_cast<int64_t>(qos_policies->lifespan.sec) * 1000000000LL +
+      static_cast<int64_t>(qos_policies->lifespan.nsec);
+  }
+#endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS && \
+          RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_MICRO */
+
   RMW_Connext_Subscriber * rmw_sub_impl =
     new (std::nothrow) RMW_Connext_Subscriber(
     ctx,
@@ -1835,7 +2333,9 @@ RMW_Connext_Subscriber::create(
 #endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
     topic_created,
     cft_topic,
-    internal);
+    internal,
+    lifespan_ns,
+    related_writer_filter);
 
   if (nullptr == rmw_sub_impl) {
     RMW_CONNEXT_LOG_ERROR_SET("failed to allocate RMW subscriber")
@@ -1860,13 +2360,37 @@ RMW_Connext_Subscriber::finalize()
   // Make sure subscriber's condition is detached from any waitset
   this->status_condition.invalidate();
 
-  if (this->loan_len > 0) {
-    this->loan_next = this->loan_len;
+  while (this->loan_count > 0) {
     if (RMW_RET_OK != this->return_messages()) {
       return RMW_RET_ERROR;
     }
   }
 
+  if (this->ctx->fast_teardown()) {
+    // The DataReader, its Topics, and the registered type will be deleted
+    // together with the DomainParticipant. Reset the reader's listener since
+    // it refers to this object's status condition. The type support is
+    // referenced by the registered type plugin, so it must outlive them.
+    if (DDS_RETCODE_OK !=
+      DDS_DataReader_set_listener(
+        this->dds_reader, nullptr, DDS_STATUS_MASK_NONE))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to reset DDS DataReader's listener")
+      return RMW_RET_ERROR;
+    }
+    rmw_ret_t rc = RMW_Connext_MessageTypeSupport::unregister_type_support(
+      this->ctx, this->dds_participant(), this->type_support->type_name(),
+      true /* keep_registered */);
+    if (RMW_RET_OK != rc) {
+      return rc;
+    }
+    if (RMW_RET_OK != this->ctx->retain_type_support(this->type_support)) {
+      return RMW_RET_ERROR;
+    }
+    this->type_support = nullptr;
+    return RMW_RET_OK;
+  }
+
   if (DDS_RETCODE_OK !=
     DDS_Subscriber_delete_datareader(
       this->dds_subscriber(), this->dds_reader))
@@ -1934,6 +2458,27 @@ RMW_Connext_Subscriber::publications_count()
   return status.current_count;
 }
 
+rmw_ret_t
+RMW_Connext_Subscriber::matched_publications(std::vector<rmw_gid_t> & gids)
+{
+  DDS_InstanceHandleSeq handles = DDS_SEQUENCE_INITIALIZER;
+  auto scope_exit_handles = rcpputils::make_scope_exit(
+    [&handles]()
+    {
+      DDS_InstanceHandleSeq_finalize(&handles);
+    });
+
+  if (DDS_RETCODE_OK !=
+    DDS_DataReader_get_matched_publications(this->dds_reader, &handles))
+  {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get matched publications")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_connextdds_handles_to_gids(&handles, gids);
+  return RMW_RET_OK;
+}
+
 
 rmw_ret_t
 RMW_Connext_Subscriber::qos(rmw_qos_profile_t * const qos)
@@ -1967,7 +2512,9 @@ RMW_Connext_Subscriber::take_message(
   void * const ros_message,
   rmw_message_info_t * const message_info,
   bool * const taken,
-  const DDS_InstanceHandle_t * const request_writer_handle)
+  const DDS_InstanceHandle_t * const request_writer_handle,
+  RMW_Connext_Client * const reply_client,
+  RMW_Connext_Service * const request_service)
 {
   *taken = false;
   size_t taken_count = 0;
@@ -1979,7 +2526,9 @@ RMW_Connext_Subscriber::take_message(
     1,
     &taken_count,
     false /* serialized*/,
-    request_writer_handle);
+    request_writer_handle,
+    reply_client,
+    request_service);
   if (RMW_RET_OK == rc) {
     *taken = taken_count > 0;
   }
@@ -2031,47 +2580,167 @@ RMW_Connext_Subscriber::take_serialized(
   return rc;
 }
 
-rmw_ret_t
-RMW_Connext_Subscriber::loan_messages()
+#if RMW_CONNEXT_EMULATE_REQUESTREPLY
+/* Read a numeric field of the (emulated) request/reply header of a
+   serialized sample, without deserializing the sample. */
+template<typename T>
+static
+bool
+rmw_connextdds_read_header_field(
+  const rcutils_uint8_array_t * const data_buffer,
+  const size_t offset,
+  T & value)
 {
-  /* this function should only be called once all previously
-     loaned messages have been returned */
-  RMW_CONNEXT_ASSERT(this->loan_len == 0)
-  RMW_CONNEXT_ASSERT(this->loan_next == 0)
+  if (data_buffer->buffer_length < offset + sizeof(T)) {
+    return false;
+  }
 
-  if (RMW_RET_OK != rmw_connextdds_take_samples(this)) {
-    return RMW_RET_ERROR;
+  uint8_t value_bytes[sizeof(T)];
+  memcpy(value_bytes, data_buffer->buffer + offset, sizeof(T));
+
+  // Swap bytes if the payload's endianness (from the encapsulation
+  // header) is different from the host's.
+  const uint16_t endianness_probe = 1;
+  const bool host_le =
+    *reinterpret_cast<const uint8_t *>(&endianness_probe) == 1;
+  const bool data_le = (data_buffer->buffer[1] & 0x01) != 0;
+  if (host_le != data_le) {
+    std::reverse(value_bytes, value_bytes + sizeof(T));
   }
+  memcpy(&value, value_bytes, sizeof(T));
+  return true;
+}
+#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
 
-  this->loan_len = DDS_UntypedSampleSeq_get_length(&this->loan_data);
+/* Read the priority of a request from its header, without deserializing
+   the request. */
+static
+int32_t
+rmw_connextdds_request_priority(
+  const rcutils_uint8_array_t * const data_buffer)
+{
+  int32_t priority = 0;
+#if RMW_CONNEXT_HAVE_REQUEST_PRIORITY
+  // The priority follows the requester's GID, the request's SN, and the
+  // (optional) target in the request header
+  // (see RMW_Connext_MessageTypeSupport::serialize()).
+  const size_t priority_offset =
+    RMW_Connext_MessageTypeSupport::ENCAPSULATION_HEADER_SIZE +
+    RMW_GID_STORAGE_SIZE + sizeof(int64_t) +
+    (RMW_CONNEXT_HAVE_REQUEST_TARGET ? RMW_GID_STORAGE_SIZE : 0);
+  if (!rmw_connextdds_read_header_field(
+      data_buffer, priority_offset, priority))
+  {
+    return std::numeric_limits<int32_t>::min();
+  }
+#else
+  UNUSED_ARG(data_buffer);
+#endif /* RMW_CONNEXT_HAVE_REQUEST_PRIORITY */
+  return priority;
+}
 
-  RMW_CONNEXT_LOG_DEBUG_A(
-    "[%s] loaned messages: %lu",
-    this->type_support->type_name(), this->loan_len)
+/* Sort the samples of a loan by decreasing request priority (samples without
+   valid data last), preserving the arrival order of equal priorities. */
+static
+void
+rmw_connextdds_order_requests(RMW_Connext_SubscriberLoan * const loan)
+{
+  std::vector<int32_t> priorities(loan->len);
+  loan->order.resize(loan->len);
+  for (size_t i = 0; i < loan->len; i++) {
+    const DDS_SampleInfo * const info =
+      DDS_SampleInfoSeq_get_reference(&loan->info, static_cast<DDS_Long>(i));
+    if (info->valid_data) {
+      priorities[i] = rmw_connextdds_request_priority(
+        reinterpret_cast<const rcutils_uint8_array_t *>(
+          DDS_UntypedSampleSeq_get_reference(
+            &loan->data, static_cast<DDS_Long>(i))));
+    } else {
+      priorities[i] = std::numeric_limits<int32_t>::min();
+    }
+    loan->order[i] = i;
+  }
 
-  return this->status_condition.set_data_available(this->loan_len > 0);
+  std::stable_sort(
+    loan->order.begin(), loan->order.end(),
+    [&priorities](const size_t a, const size_t b)
+    {
+      return priorities[a] > priorities[b];
+    });
 }
 
 rmw_ret_t
-RMW_Connext_Subscriber::return_messages()
+RMW_Connext_Subscriber::loan_messages()
 {
-  /* this function should be called only if a loan is available */
-  RMW_CONNEXT_ASSERT(this->loan_len > 0)
+  /* this function should only be called if the reader allows
+     for another outstanding loan */
+  RMW_CONNEXT_ASSERT(
+    this->loan_count < RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX)
 
-  RMW_CONNEXT_LOG_DEBUG_A(
-    "[%s] return loaned messages: %lu",
-    this->type_support->type_name(), this->loan_len)
+  RMW_Connext_SubscriberLoan * const loan =
+    &this->loans[(this->loan_head + this->loan_count) %
+    RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX];
+  RMW_CONNEXT_ASSERT(loan->len == 0)
+  RMW_CONNEXT_ASSERT(loan->next == 0)
 
-  this->loan_len = 0;
-  this->loan_next = 0;
+  if (RMW_RET_OK !=
+    rmw_connextdds_take_samples(this, &loan->data, &loan->info))
+  {
+    return RMW_RET_ERROR;
+  }
+
+  loan->len = DDS_UntypedSampleSeq_get_length(&loan->data);
+  if (loan->len > 0) {
+    this->loan_count += 1;
+  }
+
+  if (this->order_by_priority && loan->len > 1) {
+    try {
+      rmw_connextdds_order_requests(loan);
+    } catch (const std::exception & exc) {
+      // Fall back to consuming requests in arrival order
+      loan->order.clear();
+      RMW_CONNEXT_LOG_WARNING_A(
+        "failed to order requests by priority: %s", exc.what())
+    }
+  }
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "[%s] loaned messages: %lu (outstanding loans: %lu)",
+    this->type_support->type_name(), loan->len, this->loan_count)
+
+  return this->status_condition.set_data_available(
+    nullptr != this->active_loan());
+}
+
+rmw_ret_t
+RMW_Connext_Subscriber::return_messages()
+{
+  /* this function should be called only if a loan is available */
+  RMW_CONNEXT_ASSERT(this->loan_count > 0)
+
+  RMW_Connext_SubscriberLoan * const loan = &this->loans[this->loan_head];
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "[%s] return loaned messages: %lu",
+    this->type_support->type_name(), loan->len)
+
+  loan->len = 0;
+  loan->next = 0;
+  loan->order.clear();
+  this->loan_head =
+    (this->loan_head + 1) % RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX;
+  this->loan_count -= 1;
 
   rmw_ret_t rc_result = RMW_RET_OK;
-  rmw_ret_t rc = rmw_connextdds_return_samples(this);
+  rmw_ret_t rc =
+    rmw_connextdds_return_samples(this, &loan->data, &loan->info);
   if (RMW_RET_OK != rc) {
     rc_result = rc;
   }
 
-  rc = this->status_condition.set_data_available(false);
+  rc = this->status_condition.set_data_available(
+    nullptr != this->active_loan());
   if (RMW_RET_OK != rc) {
     rc_result = rc;
   }
@@ -2100,6 +2769,54 @@ RMW_Connext_Subscriber::requestreply_header_from_dds(
   rmw_connextdds_sn_dds_to_ros(*src_sn, rr_msg->sn);
 }
 
+// Deserialize samples whose deserialization was deferred by take_next().
+// Batches with enough samples are deserialized concurrently by the context's
+// worker threads (and the calling thread), while smaller ones, which would
+// not repay the cost of waking up the workers, are deserialized in place.
+static
+rmw_ret_t
+rmw_connextdds_deserialize_pending(
+  RMW_Connext_MessageTypeSupport * const type_support,
+  std::vector<std::pair<void *, rcutils_uint8_array_t *>> & samples,
+  RMW_Connext_WorkerPool * const pool)
+{
+  std::atomic_bool failed(false);
+
+  auto deserialize_sample =
+    [type_support, &samples, &failed](const size_t i)
+    {
+      if (failed.load()) {
+        return;
+      }
+      size_t deserialized_size = 0;
+      if (RMW_RET_OK !=
+        type_support->deserialize(
+          samples[i].first, samples[i].second, deserialized_size))
+      {
+        failed.store(true);
+      }
+    };
+
+  if (nullptr != pool &&
+    samples.size() >= RMW_CONNEXT_PARALLEL_DESERIALIZE_MIN_SAMPLES)
+  {
+    pool->run(samples.size(), deserialize_sample);
+  } else {
+    for (size_t i = 0; i < samples.size(); i++) {
+      deserialize_sample(i);
+    }
+  }
+
+  samples.clear();
+
+  if (failed.load()) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to deserialize taken samples")
+    return RMW_RET_ERROR;
+  }
+
+  return RMW_RET_OK;
+}
+
 rmw_ret_t
 RMW_Connext_Subscriber::take_next(
   void ** const ros_messages,
@@ -2107,35 +2824,59 @@ RMW_Connext_Subscriber::take_next(
   const size_t max_samples,
   size_t * const taken,
   const bool serialized,
-  const DDS_InstanceHandle_t * const request_writer_handle)
+  const DDS_InstanceHandle_t * const request_writer_handle,
+  RMW_Connext_Client * const reply_client,
+  RMW_Connext_Service * const request_service)
 {
   rmw_ret_t rc = RMW_RET_OK;
 
   *taken = 0;
 
+  // When enabled, samples in a batch are only filtered in the loop below,
+  // and they are deserialized once the batch is complete, or no more loans
+  // can be taken while retaining the ones it references. Whether they are
+  // deserialized concurrently depends on how many samples were taken.
+  RMW_Connext_WorkerPool * const deserialize_pool =
+    this->ctx->deserialize_pool.get();
+  const bool deserialize_parallel =
+    !serialized &&
+    max_samples >= RMW_CONNEXT_PARALLEL_DESERIALIZE_MIN_SAMPLES &&
+    nullptr != deserialize_pool;
+  std::vector<std::pair<void *, rcutils_uint8_array_t *>> pending_samples;
+
   std::lock_guard<std::mutex> lock(this->loan_mutex);
 
   while (*taken < max_samples) {
-    rc = this->loan_messages_if_needed();
+    // Consumed loans referenced by pending samples are kept, and a new one
+    // is taken alongside them, if the reader allows it.
+    rc = this->loan_messages_if_needed(pending_samples.size() > 0);
     if (RMW_RET_OK != rc) {
       return rc;
     }
 
-    if (this->loan_len == 0) {
+    RMW_Connext_SubscriberLoan * const loan = this->active_loan();
+    if (nullptr == loan) {
+      if (pending_samples.size() > 0) {
+        // Release the retained loans and try again
+        rc = rmw_connextdds_deserialize_pending(
+          this->type_support, pending_samples, deserialize_pool);
+        if (RMW_RET_OK != rc) {
+          return rc;
+        }
+        continue;
+      }
       /* no data available on reader */
-      return RMW_RET_OK;
+      break;
     }
 
-    for (; *taken < max_samples && this->loan_next < this->loan_len;
-      this->loan_next++)
-    {
+    for (; *taken < max_samples && loan->next < loan->len; loan->next++) {
       rcutils_uint8_array_t * data_buffer =
         reinterpret_cast<rcutils_uint8_array_t *>(
         DDS_UntypedSampleSeq_get_reference(
-          &this->loan_data, static_cast<DDS_Long>(this->loan_next)));
+          &loan->data, static_cast<DDS_Long>(loan->next_index())));
       DDS_SampleInfo * info =
         DDS_SampleInfoSeq_get_reference(
-        &this->loan_info, static_cast<DDS_Long>(this->loan_next));
+        &loan->info, static_cast<DDS_Long>(loan->next_index()));
 
       if (info->valid_data) {
         bool accepted = false;
@@ -2152,6 +2893,24 @@ RMW_Connext_Subscriber::take_next(
           continue;
         }
 
+        if (nullptr != reply_client &&
+          !reply_client->accept_reply(data_buffer, info))
+        {
+          RMW_CONNEXT_LOG_DEBUG_A(
+            "[%s] DROPPED reply to unknown or expired request",
+            this->type_support->type_name())
+          continue;
+        }
+
+        if (nullptr != request_service &&
+          !request_service->accept_request(info))
+        {
+          RMW_CONNEXT_LOG_DEBUG_A(
+            "[%s] DROPPED stale request",
+            this->type_support->type_name())
+          continue;
+        }
+
         void * ros_message = ros_messages[*taken];
 
         if (serialized) {
@@ -2179,39 +2938,60 @@ RMW_Connext_Subscriber::take_next(
 
             this->requestreply_header_from_dds(
               rr_msg, &identity, &related_sample_identity);
+            rr_msg->intermediate = !rr_msg->request &&
+              (info->flag & DDS_INTERMEDIATE_REPLY_SEQUENCE_SAMPLE) != 0;
           }
 #endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
-          size_t deserialized_size = 0;
-
-          if (RMW_RET_OK !=
-            this->type_support->deserialize(
-              ros_message, data_buffer, deserialized_size))
-          {
-            RMW_CONNEXT_LOG_ERROR_SET(
-              "failed to deserialize taken sample")
-            return RMW_RET_ERROR;
+          if (deserialize_parallel) {
+            try {
+              pending_samples.emplace_back(ros_message, data_buffer);
+            } catch (const std::exception & exc) {
+              RMW_CONNEXT_LOG_ERROR_A_SET(
+                "failed to queue sample for deserialization: %s", exc.what())
+              return RMW_RET_ERROR;
+            }
+          } else {
+            size_t deserialized_size = 0;
+
+            if (RMW_RET_OK !=
+              this->type_support->deserialize(
+                ros_message, data_buffer, deserialized_size))
+            {
+              RMW_CONNEXT_LOG_ERROR_SET(
+                "failed to deserialize taken sample")
+              return RMW_RET_ERROR;
+            }
           }
         }
 
         if (nullptr != message_infos) {
           rmw_message_info_t * message_info = &message_infos[*taken];
-          rmw_connextdds_message_info_from_dds(message_info, info);
+          rmw_connextdds_message_info_from_dds(
+            message_info, info, this->info_fields);
         }
 
         *taken += 1;
         continue;
       }
     }
+
   }
+
+  // Pending samples reference the outstanding loans, so they must be
+  // deserialized before any of them is returned.
+  if (pending_samples.size() > 0) {
+    rc = rmw_connextdds_deserialize_pending(
+      this->type_support, pending_samples, deserialize_pool);
+    if (RMW_RET_OK != rc) {
+      return rc;
+    }
+  }
+
   RMW_CONNEXT_LOG_DEBUG_A(
     "[%s] taken messages: %lu",
     this->type_support->type_name(), *taken)
 
-  if (this->loan_len && this->loan_next >= this->loan_len) {
-    rc = this->return_messages();
-  }
-
-  return rc;
+  return this->return_consumed_messages();
 }
 
 rmw_subscription_t *
@@ -2357,14 +3137,19 @@ constexpr uint64_t C_NANOSECONDS_PER_SEC = 1000000000ULL;
 void
 rmw_connextdds_message_info_from_dds(
   rmw_message_info_t * const to,
-  const DDS_SampleInfo * const from)
+  const DDS_SampleInfo * const from,
+  const uint32_t fields)
 {
-  rmw_connextdds_ih_to_gid(from->publication_handle, to->publisher_gid);
+  if (fields & RMW_CONNEXT_MESSAGE_INFO_PUBLISHER_GID) {
+    rmw_connextdds_ih_to_gid(from->publication_handle, to->publisher_gid);
+  }
 // Message timestamps are disabled on Windows because RTI Connext DDS
 // does not support a high enough clock resolution by default (see: _ftime()).
 #if RMW_CONNEXT_HAVE_MESSAGE_INFO_TS && !RTI_WIN32
-  to->source_timestamp = dds_time_to_u64(&from->source_timestamp);
-  to->received_timestamp = dds_time_to_u64(&from->reception_timestamp);
+  if (fields & RMW_CONNEXT_MESSAGE_INFO_TIMESTAMPS) {
+    to->source_timestamp = dds_time_to_u64(&from->source_timestamp);
+    to->received_timestamp = dds_time_to_u64(&from->reception_timestamp);
+  }
 #endif /* RMW_CONNEXT_HAVE_MESSAGE_INFO_TS */
 }
 
@@ -2707,6 +3492,8 @@ RMW_Connext_Client::create(
     RMW_CONNEXT_LOG_ERROR_SET("failed to allocate client implementation")
     return nullptr;
   }
+  client_impl->server_selection = ctx->server_selection;
+  client_impl->request_timeout_ms = ctx->request_timeout_ms;
 
   auto scope_exit_client_impl_delete = rcpputils::make_scope_exit(
     [client_impl]()
@@ -2899,6 +3686,20 @@ RMW_Connext_Client::create(
     return nullptr;
   }
 
+  // take_response() only propagates the message timestamps
+  client_impl->reply_sub->message_info_fields(
+    RMW_CONNEXT_MESSAGE_INFO_TIMESTAMPS);
+
+  // Let services pair the request writer with its reply reader, e.g. to
+  // wait for the acknowledgments of streamed replies.
+  if (RMW_RET_OK !=
+    rmw_connextdds_set_paired_endpoint(
+      client_impl->request_pub, *client_impl->reply_sub->gid()))
+  {
+    RMW_CONNEXT_LOG_ERROR("failed to advertise client's reply reader")
+    return nullptr;
+  }
+
   scope_exit_client_impl_delete.cancel();
   return client_impl;
 }
@@ -2922,23 +3723,382 @@ RMW_Connext_Client::enable()
 rmw_ret_t
 RMW_Connext_Client::is_service_available(bool & available)
 {
-  /* TODO(asorbini): check that we actually have at least one service matched by both
-     request writer and response reader */
-  available = (this->request_pub->subscriptions_count() > 0 &&
-    this->reply_sub->publications_count() > 0);
+  available = false;
+
+  // Avoid querying matched endpoints until both directions have matched
+  // something.
+  if (0 == this->request_pub->subscriptions_count() ||
+    0 == this->reply_sub->publications_count())
+  {
+    return RMW_RET_OK;
+  }
+
+  std::vector<RMW_Connext_ServerEndpoints> servers;
+  rmw_ret_t rc = this->available_servers(servers);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
+  available = !servers.empty();
+  return RMW_RET_OK;
+}
+
+// Pair an endpoint which didn't advertise its peer (e.g. because it was
+// created with Connext Micro) with the only remote endpoint from the same
+// participant (i.e. sharing the same GUID prefix). The pairing is ambiguous,
+// and thus rejected, if the participant has more than one of either.
+static bool
+rmw_connextdds_find_unique_prefix_match(
+  const rmw_gid_t & endpoint,
+  const std::vector<rmw_gid_t> & endpoints,
+  const std::vector<rmw_gid_t> & peers,
+  rmw_gid_t & peer)
+{
+  auto same_prefix = [&endpoint](const rmw_gid_t & other)
+    {
+      return memcmp(
+        endpoint.data, other.data, RMW_CONNEXT_GUID_PREFIX_SIZE) == 0;
+    };
+
+  if (std::count_if(endpoints.begin(), endpoints.end(), same_prefix) != 1) {
+    return false;
+  }
+
+  bool found = false;
+  for (const auto & candidate : peers) {
+    if (same_prefix(candidate)) {
+      if (found) {
+        return false;
+      }
+      peer = candidate;
+      found = true;
+    }
+  }
+  return found;
+}
+
+rmw_ret_t
+RMW_Connext_Client::available_servers(
+  std::vector<RMW_Connext_ServerEndpoints> & servers)
+{
+  servers.clear();
+
+  std::vector<rmw_gid_t> request_readers;
+  rmw_ret_t rc = this->request_pub->matched_subscriptions(request_readers);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
+  std::vector<rmw_gid_t> reply_writers;
+  rc = this->reply_sub->matched_publications(reply_writers);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
+  // Each server advertises the request reader paired with its reply writer.
+  // Only report servers which have been matched in both directions, since
+  // requests sent to a server whose reply writer hasn't been matched yet
+  // would be lost.
+  for (const auto & reply_writer : reply_writers) {
+    rmw_gid_t paired_reader;
+    bool paired = false;
+    rc = rmw_connextdds_get_paired_endpoint(
+      this->reply_sub, reply_writer, paired_reader, paired);
+    if (RMW_RET_OK != rc) {
+      return rc;
+    }
+    if (!paired &&
+      !rmw_connextdds_find_unique_prefix_match(
+        reply_writer, reply_writers, request_readers, paired_reader))
+    {
+      continue;
+    }
+    for (const auto & request_reader : request_readers) {
+      if (memcmp(
+          request_reader.data,
+          paired_reader.data,
+          sizeof(paired_reader.data)) == 0)
+      {
+        servers.push_back({request_reader, reply_writer});
+        break;
+      }
+    }
+  }
+
   return RMW_RET_OK;
 }
 
+void
+RMW_Connext_Client::select_server(
+  const std::vector<RMW_Connext_ServerEndpoints> & servers,
+  rmw_gid_t & target,
+  rmw_gid_t & server)
+{
+  memset(target.data, 0, sizeof(target.data));
+  target.implementation_identifier = RMW_CONNEXTDDS_ID;
+  memset(server.data, 0, sizeof(server.data));
+  server.implementation_identifier = RMW_CONNEXTDDS_ID;
+
+  if (RMW_CONNEXT_SERVER_SELECTION_ALL == this->server_selection) {
+    return;
+  }
+
+  this->drop_departed_requests(servers);
+
+  if (servers.empty()) {
+    // Let any server handle the request, e.g. one that hasn't been
+    // matched in both directions yet.
+    return;
+  }
+
+  size_t selected = 0;
+  switch (this->server_selection) {
+    case RMW_CONNEXT_SERVER_SELECTION_ROUND_ROBIN:
+      {
+        selected = this->selection_next % servers.size();
+        this->selection_next = selected + 1;
+        break;
+      }
+    case RMW_CONNEXT_SERVER_SELECTION_LEAST_OUTSTANDING:
+      {
+        size_t selected_load = SIZE_MAX;
+        for (size_t i = 0; i < servers.size(); i++) {
+          const size_t load = this->server_load(servers[i].reply_writer);
+          if (load < selected_load) {
+            selected = i;
+            selected_load = load;
+          }
+        }
+        break;
+      }
+    case RMW_CONNEXT_SERVER_SELECTION_AFFINITY:
+      {
+        bool found = false;
+        if (this->selection_has_affinity) {
+          for (size_t i = 0; i < servers.size() && !found; i++) {
+            if (memcmp(
+                servers[i].reply_writer.data,
+                this->selection_affinity.data,
+                sizeof(this->selection_affinity.data)) == 0)
+            {
+              selected = i;
+              found = true;
+            }
+          }
+        }
+        if (!found) {
+          this->selection_affinity = servers[selected].reply_writer;
+          this->selection_has_affinity = true;
+        }
+        break;
+      }
+    default:
+      {
+        return;
+      }
+  }
+
+  memcpy(
+    target.data,
+    servers[selected].request_reader.data,
+    sizeof(target.data));
+  server = servers[selected].reply_writer;
+}
+
+void
+RMW_Connext_Client::drop_departed_requests(
+  const std::vector<RMW_Connext_ServerEndpoints> & servers)
+{
+  static const rmw_gid_t any_server = {};
+
+  auto it = this->pending_requests.begin();
+  while (it != this->pending_requests.end()) {
+    const rmw_gid_t & server = it->second.server;
+    bool available = memcmp(
+      server.data, any_server.data, sizeof(server.data)) == 0;
+    for (size_t i = 0; i < servers.size() && !available; i++) {
+      available = memcmp(
+        server.data,
+        servers[i].reply_writer.data,
+        sizeof(server.data)) == 0;
+    }
+    if (available) {
+      ++it;
+      continue;
+    }
+    RMW_CONNEXT_LOG_DEBUG_A(
+      "[%s] server no longer available, dropping request: sn=%ld",
+      this->request_pub->message_type_support()->type_name(), it->first)
+    it = this->pending_requests.erase(it);
+  }
+}
+
+size_t
+RMW_Connext_Client::server_load(const rmw_gid_t & reply_writer)
+{
+  size_t load = 0;
+  for (const auto & pending : this->pending_requests) {
+    if (memcmp(
+        reply_writer.data,
+        pending.second.server.data,
+        sizeof(reply_writer.data)) == 0)
+    {
+      load += 1;
+    }
+  }
+  return load;
+}
+
+void
+RMW_Connext_Client::expire_requests(const bool make_room)
+{
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RMW_CONNEXT_LOG_ERROR("failed to get current time")
+    return;
+  }
+
+  auto it = this->pending_requests.begin();
+  bool evict = make_room;
+  while (it != this->pending_requests.end()) {
+    const bool expired =
+      0 != it->second.deadline && it->second.deadline <= now;
+    if (!expired && !evict) {
+      // Deadlines only increase with sequence numbers, unless the timeout
+      // was changed, so stop at the first request which hasn't expired.
+      break;
+    }
+    RMW_CONNEXT_LOG_DEBUG_A(
+      "[%s] request timed out: sn=%ld",
+      this->request_pub->message_type_support()->type_name(), it->first)
+    this->timeout_status.total_count += 1;
+    this->timeout_status.total_count_change += 1;
+    this->timeout_status.last_sequence_number = it->first;
+    it = this->pending_requests.erase(it);
+    evict = false;
+  }
+}
+
+/* Extract the sequence number of the request related to a reply, without
+   deserializing the reply. */
+static
+bool
+rmw_connextdds_reply_related_sn(
+  const rcutils_uint8_array_t * const data_buffer,
+  const DDS_SampleInfo * const info,
+  int64_t & sn)
+{
+#if RMW_CONNEXT_EMULATE_REQUESTREPLY
+  UNUSED_ARG(info);
+  // The SN follows the requester's GID in the reply header
+  // (see RMW_Connext_MessageTypeSupport::serialize()).
+  const size_t sn_offset =
+    RMW_Connext_MessageTypeSupport::ENCAPSULATION_HEADER_SIZE +
+    RMW_GID_STORAGE_SIZE;
+  return rmw_connextdds_read_header_field(data_buffer, sn_offset, sn);
+#else
+  UNUSED_ARG(data_buffer);
+  DDS_SampleIdentity_t related_sample_identity;
+  DDS_SampleInfo_get_related_sample_identity(info, &related_sample_identity);
+  rmw_connextdds_sn_dds_to_ros(related_sample_identity.sequence_number, sn);
+  return true;
+#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
+}
+
+/* Check whether a reply is an intermediate part of a streamed response,
+   without deserializing the reply. */
+static
+bool
+rmw_connextdds_reply_intermediate(
+  const rcutils_uint8_array_t * const data_buffer,
+  const DDS_SampleInfo * const info)
+{
+#if !RMW_CONNEXT_HAVE_REPLY_STREAM
+  UNUSED_ARG(data_buffer);
+  UNUSED_ARG(info);
+  return false;
+#elif RMW_CONNEXT_EMULATE_REQUESTREPLY
+  UNUSED_ARG(info);
+  // The flags follow the requester's GID and the request's SN in the
+  // reply header (see RMW_Connext_MessageTypeSupport::serialize()).
+  const size_t flags_offset =
+    RMW_Connext_MessageTypeSupport::ENCAPSULATION_HEADER_SIZE +
+    RMW_GID_STORAGE_SIZE + sizeof(int64_t);
+  int32_t flags = 0;
+  return rmw_connextdds_read_header_field(data_buffer, flags_offset, flags) &&
+         (flags & RMW_Connext_MessageTypeSupport::REPLY_FLAG_INTERMEDIATE) != 0;
+#else
+  UNUSED_ARG(data_buffer);
+  return (info->flag & DDS_INTERMEDIATE_REPLY_SEQUENCE_SAMPLE) != 0;
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
+}
+
+bool
+RMW_Connext_Client::accept_reply(
+  const rcutils_uint8_array_t * const data_buffer,
+  const DDS_SampleInfo * const info)
+{
+  int64_t sn = 0;
+  if (!rmw_connextdds_reply_related_sn(data_buffer, info, sn)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(this->pending_mutex);
+  this->expire_requests(false /* make_room */);
+
+  auto it = this->pending_requests.find(sn);
+  if (it == this->pending_requests.end()) {
+    // Reply to a request that already timed out, or that was already
+    // replied to (e.g. by another server).
+    return false;
+  }
+
+  if (rmw_connextdds_reply_intermediate(data_buffer, info)) {
+    // More parts of the response will follow: keep tracking the request,
+    // and restart its timeout.
+    if (0 != it->second.deadline) {
+      rcutils_time_point_value_t now = 0;
+      if (RCUTILS_RET_OK == rcutils_steady_time_now(&now)) {
+        it->second.deadline = now + RCUTILS_MS_TO_NS(this->request_timeout_ms);
+      }
+    }
+    return true;
+  }
+
+  this->pending_requests.erase(it);
+  return true;
+}
+
+void
+RMW_Connext_Client::request_timeout_status(
+  rmw_connextdds_request_timeout_status_t & status)
+{
+  std::lock_guard<std::mutex> guard(this->pending_mutex);
+  this->expire_requests(false /* make_room */);
+  status = this->timeout_status;
+  this->timeout_status.total_count_change = 0;
+}
+
+size_t
+RMW_Connext_Client::pending_requests_count()
+{
+  std::lock_guard<std::mutex> guard(this->pending_mutex);
+  this->expire_requests(false /* make_room */);
+  return this->pending_requests.size();
+}
+
 rmw_ret_t
 RMW_Connext_Client::take_response(
   rmw_service_info_t * const request_header,
   void * const ros_response,
-  bool * const taken)
+  bool * const taken,
+  bool * const last)
 {
   *taken = false;
 
   RMW_Connext_RequestReplyMessage rr_msg;
   rr_msg.request = false;
+  rr_msg.intermediate = false;
   rr_msg.payload = ros_response;
 
   rmw_message_info_t message_info;
@@ -2949,13 +4109,17 @@ RMW_Connext_Client::take_response(
 
   rmw_ret_t rc =
     this->reply_sub->take_message(
-    &rr_msg, &message_info, &taken_msg, &req_writer_handle);
+    &rr_msg, &message_info, &taken_msg, &req_writer_handle, this);
 
   if (RMW_RET_OK != rc) {
     return rc;
   }
 
   if (taken_msg) {
+    if (nullptr != last) {
+      *last = !rr_msg.intermediate;
+    }
+
     request_header->request_id.sequence_number = rr_msg.sn;
     memcpy(
       request_header->request_id.writer_guid,
@@ -2993,15 +4157,45 @@ RMW_Connext_Client::send_request(
   RMW_Connext_RequestReplyMessage rr_msg;
   rr_msg.request = true;
 
-#if RMW_CONNEXT_EMULATE_REQUESTREPLY
   *sequence_id = ++this->next_request_id;
   rr_msg.sn = *sequence_id;
-#else
-  rr_msg.sn = -1;
-#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
   rr_msg.gid = *this->request_pub->gid();
+  rr_msg.priority = this->request_priority;
   rr_msg.payload = const_cast<void *>(ros_request);
 
+  std::vector<RMW_Connext_ServerEndpoints> servers;
+  if (RMW_CONNEXT_SERVER_SELECTION_ALL != this->server_selection) {
+    rmw_ret_t rc = this->available_servers(servers);
+    if (RMW_RET_OK != rc) {
+      return rc;
+    }
+  }
+
+  {
+    // Track the request before writing it, so that its reply may not be
+    // received (and discarded) before then.
+    std::lock_guard<std::mutex> guard(this->pending_mutex);
+
+    PendingRequest pending;
+    pending.deadline = 0;
+    if (this->request_timeout_ms > 0) {
+      if (RCUTILS_RET_OK != rcutils_steady_time_now(&pending.deadline)) {
+        RMW_CONNEXT_LOG_ERROR_SET("failed to get current time")
+        return RMW_RET_ERROR;
+      }
+      pending.deadline += RCUTILS_MS_TO_NS(this->request_timeout_ms);
+    }
+
+    if (this->pending_requests.size() >= RMW_CONNEXT_LIMIT_PENDING_REQUESTS_MAX) {
+      // Never fail a request because of older ones: the oldest request is
+      // considered timed out (even without a timeout) to make room for it.
+      this->expire_requests(true /* make_room */);
+    }
+
+    this->select_server(servers, rr_msg.target, pending.server);
+    this->pending_requests[rr_msg.sn] = pending;
+  }
+
   RMW_CONNEXT_LOG_DEBUG_A(
     "[%s] send REQUEST: "
     "gid=%08X.%08X.%08X.%08X, "
@@ -3013,7 +4207,12 @@ RMW_Connext_Client::send_request(
     reinterpret_cast<const uint32_t *>(rr_msg.gid.data)[3],
     rr_msg.sn)
 
-  rmw_ret_t rc = this->request_pub->write(&rr_msg, false /* serialized */, sequence_id);
+  rmw_ret_t rc = this->request_pub->write(&rr_msg, false /* serialized */);
+  if (RMW_RET_OK != rc) {
+    std::lock_guard<std::mutex> guard(this->pending_mutex);
+    this->pending_requests.erase(rr_msg.sn);
+    return rc;
+  }
 
   RMW_CONNEXT_LOG_DEBUG_A(
     "[%s] SENT REQUEST: "
@@ -3026,7 +4225,7 @@ RMW_Connext_Client::send_request(
     reinterpret_cast<const uint32_t *>(rr_msg.gid.data)[3],
     *sequence_id)
 
-  return rc;
+  return RMW_RET_OK;
 }
 
 rmw_ret_t
@@ -3077,6 +4276,25 @@ RMW_Connext_Service::create(
       delete svc_impl;
     });
 
+  svc_impl->discard_departed = ctx->discard_departed_requests;
+  svc_impl->request_max_age_ms = ctx->request_max_age_ms;
+
+  // Parts of a streamed reply must be acknowledged before they may be
+  // replaced in the reply writer's history.
+  if (RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT != qos_policies->reliability) {
+    svc_impl->stream_window = RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW;
+    if (RMW_QOS_POLICY_HISTORY_KEEP_ALL != qos_policies->history &&
+      qos_policies->depth > 0 &&
+      qos_policies->depth < svc_impl->stream_window)
+    {
+      svc_impl->stream_window = qos_policies->depth;
+    }
+  }
+  if (ctx->write_blocking_time_ms >= 0) {
+    rmw_connextdds_duration_from_ms(
+      ctx->write_blocking_time_ms, &svc_impl->stream_max_wait);
+  }
+
   bool svc_members_req_cpp = false,
     svc_members_res_cpp = false;
   const void * svc_members_req = nullptr,
@@ -3185,6 +4403,20 @@ RMW_Connext_Service::create(
     return nullptr;
   }
 
+  // take_request() only propagates the message timestamps
+  svc_impl->request_sub->message_info_fields(
+    RMW_CONNEXT_MESSAGE_INFO_TIMESTAMPS);
+
+  // Let clients pair the reply writer with its request reader, since
+  // multiple services with the same name may share a participant.
+  if (RMW_RET_OK !=
+    rmw_connextdds_set_paired_endpoint(
+      svc_impl->reply_pub, *svc_impl->request_sub->gid()))
+  {
+    RMW_CONNEXT_LOG_ERROR("failed to advertise service's request reader")
+    return nullptr;
+  }
+
   scope_exit_svc_impl_delete.cancel();
   return svc_impl;
 }
@@ -3205,6 +4437,79 @@ RMW_Connext_Service::enable()
   return RMW_RET_OK;
 }
 
+bool
+RMW_Connext_Service::client_matched(const DDS_InstanceHandle_t & request_writer)
+{
+  DDS_SubscriptionMatchedStatus status =
+    DDS_SubscriptionMatchedStatus_INITIALIZER;
+  if (DDS_RETCODE_OK !=
+    DDS_DataReader_get_subscription_matched_status(
+      this->request_sub->reader(), &status))
+  {
+    RMW_CONNEXT_LOG_ERROR("failed to get subscription matched status")
+    // Deliver the request if the client's state is unknown
+    return true;
+  }
+
+  // Any match increases total_count, while unmatches only decrease
+  // current_count, so the cache is stale if either one changed.
+  if (status.total_count != this->matched_total_count ||
+    status.current_count != this->matched_current_count)
+  {
+    if (RMW_RET_OK !=
+      this->request_sub->matched_publications(this->matched_clients))
+    {
+      return true;
+    }
+    this->matched_total_count = status.total_count;
+    this->matched_current_count = status.current_count;
+  }
+
+  rmw_gid_t writer_gid;
+  rmw_connextdds_ih_to_gid(request_writer, writer_gid);
+
+  for (const rmw_gid_t & client_gid : this->matched_clients) {
+    if (memcmp(client_gid.data, writer_gid.data, RMW_GID_STORAGE_SIZE) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+RMW_Connext_Service::accept_request(const DDS_SampleInfo * const info)
+{
+  std::lock_guard<std::mutex> guard(this->discard_mutex);
+
+  if (this->request_max_age_ms > 0) {
+    rcutils_time_point_value_t now = 0;
+    if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+      RMW_CONNEXT_LOG_ERROR("failed to get current time")
+      return true;
+    }
+
+    const int64_t source_ts =
+      static_cast<int64_t>(info->source_timestamp.sec) * 1000000000LL +
+      static_cast<int64_t>(info->source_timestamp.nanosec);
+
+    if (now - source_ts > this->request_max_age_ms * 1000000LL) {
+      this->discard_status.expired_count += 1;
+      this->discard_status.total_count_change += 1;
+      return false;
+    }
+  }
+
+  if (this->discard_departed &&
+    !this->client_matched(info->publication_handle))
+  {
+    this->discard_status.departed_count += 1;
+    this->discard_status.total_count_change += 1;
+    return false;
+  }
+
+  return true;
+}
+
 rmw_ret_t
 RMW_Connext_Service::take_request(
   rmw_service_info_t * const request_header,
@@ -3222,7 +4527,10 @@ RMW_Connext_Service::take_request(
 
   rmw_ret_t rc =
     this->request_sub->take_message(
-    &rr_msg, &message_info, &taken_msg);
+    &rr_msg, &message_info, &taken_msg,
+    nullptr /* request_writer_handle */,
+    nullptr /* reply_client */,
+    this);
 
   if (RMW_RET_OK != rc) {
     return rc;
@@ -3262,10 +4570,13 @@ RMW_Connext_Service::take_request(
 rmw_ret_t
 RMW_Connext_Service::send_response(
   rmw_request_id_t * const request_id,
-  const void * const ros_response)
+  const void * const ros_response,
+  const bool last,
+  int64_t * const sn_out)
 {
   RMW_Connext_RequestReplyMessage rr_msg;
   rr_msg.request = false;
+  rr_msg.intermediate = !last;
   rr_msg.sn = request_id->sequence_number;
   memcpy(rr_msg.gid.data, request_id->writer_guid, 16);
   rr_msg.gid.implementation_identifier = RMW_CONNEXTDDS_ID;
@@ -3282,7 +4593,150 @@ RMW_Connext_Service::send_response(
     reinterpret_cast<const uint32_t *>(rr_msg.gid.data)[3],
     rr_msg.sn)
 
-  return this->reply_pub->write(&rr_msg, false /* serialized */);
+  return this->reply_pub->write(&rr_msg, false /* serialized */, sn_out);
+}
+
+rmw_ret_t
+RMW_Connext_Service::send_response_part(
+  rmw_request_id_t * const request_id,
+  const void * const ros_response,
+  const bool last)
+{
+  if (0 == this->stream_window) {
+    return this->send_response(request_id, ros_response, last);
+  }
+
+  rmw_gid_t client;
+  memset(&client, 0, sizeof(client));
+  memcpy(client.data, request_id->writer_guid, 16);
+  client.implementation_identifier = RMW_CONNEXTDDS_ID;
+
+  std::list<ReplyStream>::iterator stream;
+  {
+    std::lock_guard<std::mutex> guard(this->stream_mutex);
+    stream = this->streams.begin();
+    while (stream != this->streams.end() &&
+      (stream->request_sn != request_id->sequence_number ||
+      memcmp(stream->client.data, client.data, 16) != 0))
+    {
+      ++stream;
+    }
+    if (stream == this->streams.end()) {
+      rmw_gid_t reader;
+      bool found = false;
+      rmw_ret_t rc = this->find_reply_reader(client, reader, found);
+      if (RMW_RET_OK != rc) {
+        return rc;
+      }
+      if (!found) {
+        // There are no acknowledgments to wait for if the client's reply
+        // reader is not matched (or can't be told apart from the readers of
+        // other clients), so send the part without tracking it.
+        stream = this->streams.end();
+      } else {
+        this->drop_departed_streams();
+        stream = this->streams.insert(
+          this->streams.end(),
+          ReplyStream{client, reader, request_id->sequence_number, {}, true});
+      }
+    } else {
+      stream->busy = true;
+    }
+  }
+  if (stream == this->streams.end()) {
+    return this->send_response(request_id, ros_response, last);
+  }
+
+  // Only the stream's own parts count towards its window, so that a slow
+  // client doesn't delay the replies sent to other clients.
+  rmw_ret_t rc = RMW_RET_OK;
+  bool matched = true;
+  while (RMW_RET_OK == rc && matched &&
+    stream->parts.size() >= this->stream_window)
+  {
+    rc = rmw_connextdds_wait_for_reply_acknowledgment(
+      this->reply_pub, stream->reader, stream->parts.front(),
+      &this->stream_max_wait, matched);
+    if (RMW_RET_OK == rc && matched) {
+      stream->parts.pop_front();
+    }
+  }
+
+  int64_t sn = 0;
+  if (RMW_RET_OK == rc) {
+    rc = this->send_response(request_id, ros_response, last, &sn);
+  }
+
+  std::lock_guard<std::mutex> guard(this->stream_mutex);
+  if (RMW_RET_OK != rc || !matched || last) {
+    // Drop the stream once complete, and also if a part failed (or timed
+    // out), or if its client is gone, since it would stall the next parts.
+    this->streams.erase(stream);
+  } else {
+    stream->parts.push_back(sn);
+    stream->busy = false;
+  }
+
+  return rc;
+}
+
+rmw_ret_t
+RMW_Connext_Service::find_reply_reader(
+  const rmw_gid_t & client,
+  rmw_gid_t & reader,
+  bool & found)
+{
+  // Clients advertise their reply reader in their request writer's
+  // discovery data.
+  rmw_ret_t rc = rmw_connextdds_get_paired_endpoint(
+    this->request_sub, client, reader, found);
+  if (RMW_RET_OK != rc || found) {
+    return rc;
+  }
+
+  std::vector<rmw_gid_t> request_writers;
+  rc = this->request_sub->matched_publications(request_writers);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+  std::vector<rmw_gid_t> reply_readers;
+  rc = this->reply_pub->matched_subscriptions(reply_readers);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+  found = rmw_connextdds_find_unique_prefix_match(
+    client, request_writers, reply_readers, reader);
+  return RMW_RET_OK;
+}
+
+void
+RMW_Connext_Service::drop_departed_streams()
+{
+  std::vector<rmw_gid_t> readers;
+  if (RMW_RET_OK != this->reply_pub->matched_subscriptions(readers)) {
+    return;
+  }
+
+  auto stream = this->streams.begin();
+  while (stream != this->streams.end()) {
+    const bool matched =
+      std::any_of(
+      readers.begin(), readers.end(),
+      [&stream](const rmw_gid_t & reader)
+      {
+        return memcmp(
+          reader.data, stream->reader.data, sizeof(reader.data)) == 0;
+      });
+    if (!matched && !stream->busy) {
+      RMW_CONNEXT_LOG_DEBUG_A(
+        "[%s] dropping reply stream of departed client: sn=%ld",
+        this->reply_pub->message_type_support()->type_name(),
+        stream->request_sn)
+      stream = this->streams.erase(stream);
+    } else {
+      ++stream;
+    }
+  }
 }
 
 rmw_ret_t
@@ -4263,8 +5717,14 @@ RMW_Connext_SubscriberStatusCondition::get_status(
           return RMW_RET_ERROR;
         }
 
-        status->total_count = dds_status.total_count;
-        status->total_count_change = dds_status.total_count_change;
+        // Include samples dropped by the emulated lifespan policy
+        const uint64_t expired = this->samples_expired.load();
+        const uint64_t expired_change = this->samples_expired_change.exchange(0);
+
+        status->total_count =
+          dds_status.total_count + static_cast<size_t>(expired);
+        status->total_count_change =
+          dds_status.total_count_change + static_cast<size_t>(expired_change);
 
         break;
       }
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <vector>
 
 #include "rmw_connextdds/rmw_impl.hpp"
 
@@ -221,6 +222,42 @@ rmw_api_connextdds_service_server_is_available(
 }
 
 
+rmw_ret_t
+rmw_api_connextdds_client_get_available_servers(
+  const rmw_client_t * client,
+  rmw_gid_t * servers,
+  const size_t servers_len,
+  size_t * servers_count)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client,
+    client->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (servers_len > 0) {
+    RMW_CHECK_ARGUMENT_FOR_NULL(servers, RMW_RET_INVALID_ARGUMENT);
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(servers_count, RMW_RET_INVALID_ARGUMENT);
+
+  RMW_Connext_Client * const client_impl =
+    reinterpret_cast<RMW_Connext_Client *>(client->data);
+
+  std::vector<RMW_Connext_ServerEndpoints> available;
+  rmw_ret_t rc = client_impl->available_servers(available);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
+  for (size_t i = 0; i < available.size() && i < servers_len; i++) {
+    servers[i] = available[i].reply_writer;
+  }
+  *servers_count = available.size();
+
+  return RMW_RET_OK;
+}
+
+
 rmw_ret_t
 rmw_api_connextdds_count_publishers(
   const rmw_node_t * node,
@@ -69,7 +69,7 @@ rmw_api_connextdds_create_node(
 
   rmw_context_impl_t * ctx = context->impl;
 
-  if (ctx->is_shutdown) {
+  if (ctx->is_context_shutdown(context)) {
     RMW_CONNEXT_LOG_ERROR_SET("context already shutdown")
     return nullptr;
   }
@@ -221,6 +221,13 @@ rmw_api_connextdds_destroy_node(rmw_node_t * rmw_node)
   RMW_Connext_Node * const node_impl =
     reinterpret_cast<RMW_Connext_Node *>(rmw_node->data);
 
+  // Finalize the node first, since it may refuse to be finalized
+  // (e.g. if some of its endpoints still exist).
+  if (RMW_RET_OK != node_impl->finalize()) {
+    RMW_CONNEXT_LOG_ERROR("failed to finalize node implementation")
+    return RMW_RET_ERROR;
+  }
+
   if (RMW_RET_OK !=
     rmw_connextdds_graph_on_node_deleted(ctx, rmw_node))
   {
@@ -258,6 +265,28 @@ rmw_api_connextdds_node_get_graph_guard_condition(const rmw_node_t * rmw_node)
   return node_impl->graph_guard_condition();
 }
 
+
+rmw_ret_t
+rmw_api_connextdds_node_get_incompatible_type_status(
+  const rmw_node_t * rmw_node,
+  rmw_connextdds_incompatible_type_status_t * status)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(rmw_node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_node,
+    rmw_node->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(status, RMW_RET_INVALID_ARGUMENT);
+
+  RMW_Connext_Node * const node_impl =
+    reinterpret_cast<RMW_Connext_Node *>(rmw_node->data);
+
+  node_impl->incompatible_type_status(*status);
+
+  return RMW_RET_OK;
+}
+
 #if RMW_CONNEXT_RELEASE <= RMW_CONNEXT_RELEASE_ELOQUENT
 
 rmw_ret_t
@@ -170,13 +170,15 @@ rmw_api_connextdds_create_publisher(
   }
 
   rmw_context_impl_t * ctx = node->context->impl;
+  RMW_Connext_Node * const node_impl =
+    reinterpret_cast<RMW_Connext_Node *>(node->data);
 
   rmw_publisher_t * const rmw_pub =
     rmw_connextdds_create_publisher(
     ctx,
     node,
     ctx->participant,
-    ctx->dds_pub,
+    node_impl->dds_publisher(),
     type_supports,
     topic_name,
     qos_policies
@@ -311,6 +313,48 @@ rmw_api_connextdds_publisher_get_actual_qos(
 }
 
 
+rmw_ret_t
+rmw_api_connextdds_publisher_get_write_timeouts(
+  const rmw_publisher_t * publisher,
+  uint64_t * timeouts)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher,
+    publisher->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  RMW_CHECK_ARGUMENT_FOR_NULL(timeouts, RMW_RET_INVALID_ARGUMENT);
+
+  RMW_Connext_Publisher * const pub_impl =
+    reinterpret_cast<RMW_Connext_Publisher *>(publisher->data);
+
+  *timeouts = pub_impl->write_timeouts();
+  return RMW_RET_OK;
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_publisher_set_flow_rate(
+  const rmw_publisher_t * publisher,
+  uint64_t rate,
+  uint64_t burst)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher,
+    publisher->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  RMW_Connext_Publisher * const pub_impl =
+    reinterpret_cast<RMW_Connext_Publisher *>(publisher->data);
+
+  return rmw_connextdds_set_flow_rate(pub_impl, rate, burst);
+}
+
+
 rmw_ret_t
 rmw_api_connextdds_borrow_loaned_message(
   const rmw_publisher_t * publisher,
@@ -187,13 +187,15 @@ rmw_api_connextdds_create_client(
     service_name)
 
   rmw_context_impl_t * ctx = node->context->impl;
+  RMW_Connext_Node * const node_impl =
+    reinterpret_cast<RMW_Connext_Node *>(node->data);
 
   RMW_Connext_Client * const client_impl =
     RMW_Connext_Client::create(
     ctx,
     ctx->participant,
-    ctx->dds_pub,
-    ctx->dds_sub,
+    node_impl->dds_publisher(),
+    node_impl->dds_subscriber(),
     type_supports,
     service_name,
     qos_policies);
@@ -334,13 +336,15 @@ rmw_api_connextdds_create_service(
     service_name)
 
   rmw_context_impl_t * ctx = node->context->impl;
+  RMW_Connext_Node * const node_impl =
+    reinterpret_cast<RMW_Connext_Node *>(node->data);
 
   RMW_Connext_Service * const svc_impl =
     RMW_Connext_Service::create(
     ctx,
     ctx->participant,
-    ctx->dds_pub,
-    ctx->dds_sub,
+    node_impl->dds_publisher(),
+    node_impl->dds_subscriber(),
     type_supports,
     service_name,
     qos_policies);
@@ -436,3 +440,220 @@ rmw_api_connextdds_destroy_service(
 
   return RMW_RET_OK;
 }
+
+
+rmw_ret_t
+rmw_api_connextdds_client_set_request_timeout(
+  const rmw_client_t * client,
+  const int64_t timeout_ms)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client,
+    client->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (timeout_ms < 0) {
+    RMW_CONNEXT_LOG_ERROR_SET("invalid request timeout")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  RMW_Connext_Client * const client_impl =
+    reinterpret_cast<RMW_Connext_Client *>(client->data);
+
+  client_impl->set_request_timeout(timeout_ms);
+
+  return RMW_RET_OK;
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_client_get_request_timeout_status(
+  const rmw_client_t * client,
+  rmw_connextdds_request_timeout_status_t * status)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client,
+    client->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(status, RMW_RET_INVALID_ARGUMENT);
+
+  RMW_Connext_Client * const client_impl =
+    reinterpret_cast<RMW_Connext_Client *>(client->data);
+
+  client_impl->request_timeout_status(*status);
+
+  return RMW_RET_OK;
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_client_get_pending_requests_count(
+  const rmw_client_t * client,
+  size_t * count)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client,
+    client->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(count, RMW_RET_INVALID_ARGUMENT);
+
+  RMW_Connext_Client * const client_impl =
+    reinterpret_cast<RMW_Connext_Client *>(client->data);
+
+  *count = client_impl->pending_requests_count();
+
+  return RMW_RET_OK;
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_client_set_request_priority(
+  const rmw_client_t * client,
+  const int32_t priority)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client,
+    client->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+#if RMW_CONNEXT_HAVE_REQUEST_PRIORITY
+  RMW_Connext_Client * const client_impl =
+    reinterpret_cast<RMW_Connext_Client *>(client->data);
+
+  client_impl->set_request_priority(priority);
+
+  return RMW_RET_OK;
+#else
+  UNUSED_ARG(priority);
+  RMW_CONNEXT_LOG_ERROR_SET(
+    "request priorities require RMW_CONNEXT_EMULATE_REQUESTREPLY_PRIORITY")
+  return RMW_RET_UNSUPPORTED;
+#endif /* RMW_CONNEXT_HAVE_REQUEST_PRIORITY */
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_send_response_part(
+  const rmw_service_t * service,
+  rmw_request_id_t * request_id,
+  void * ros_response,
+  const bool last)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(service, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    service,
+    service->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(request_id, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_INVALID_ARGUMENT);
+
+#if RMW_CONNEXT_HAVE_REPLY_STREAM
+  RMW_Connext_Service * const svc_impl =
+    reinterpret_cast<RMW_Connext_Service *>(service->data);
+
+  return svc_impl->send_response_part(request_id, ros_response, last);
+#else
+  UNUSED_ARG(last);
+  RMW_CONNEXT_LOG_ERROR_SET(
+    "streamed replies require RMW_CONNEXT_EMULATE_REQUESTREPLY_STREAM")
+  return RMW_RET_UNSUPPORTED;
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_take_response_part(
+  const rmw_client_t * client,
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  rmw_service_info_t * request_header,
+#else
+  rmw_request_id_t * request_header,
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+  void * ros_response,
+  bool * last,
+  bool * taken)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client,
+    client->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(request_header, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(last, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+
+  RMW_Connext_Client * const client_impl =
+    reinterpret_cast<RMW_Connext_Client *>(client->data);
+
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  return client_impl->take_response(
+    request_header, ros_response, taken, last);
+#else
+  rmw_service_info_t request_header_s;
+  rmw_ret_t rc =
+    client_impl->take_response(&request_header_s, ros_response, taken, last);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+  *request_header = request_header_s.request_id;
+  return RMW_RET_OK;
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_service_set_request_discard(
+  const rmw_service_t * service,
+  const bool discard_departed,
+  const int64_t max_age_ms)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(service, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    service,
+    service->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (max_age_ms < 0) {
+    RMW_CONNEXT_LOG_ERROR_SET("invalid request max age")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  RMW_Connext_Service * const svc_impl =
+    reinterpret_cast<RMW_Connext_Service *>(service->data);
+
+  svc_impl->set_request_discard(discard_departed, max_age_ms);
+
+  return RMW_RET_OK;
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_service_get_request_discard_status(
+  const rmw_service_t * service,
+  rmw_connextdds_request_discard_status_t * status)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(service, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    service,
+    service->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(status, RMW_RET_INVALID_ARGUMENT);
+
+  RMW_Connext_Service * const svc_impl =
+    reinterpret_cast<RMW_Connext_Service *>(service->data);
+
+  svc_impl->request_discard_status(*status);
+
+  return RMW_RET_OK;
+}
@@ -103,13 +103,15 @@ rmw_api_connextdds_create_subscription(
   }
 
   rmw_context_impl_t * ctx = node->context->impl;
+  RMW_Connext_Node * const node_impl =
+    reinterpret_cast<RMW_Connext_Node *>(node->data);
 
   rmw_subscription_t * const rmw_sub =
     rmw_connextdds_create_subscriber(
     ctx,
     node,
     ctx->participant,
-    ctx->dds_sub,
+    node_impl->dds_subscriber(),
     type_supports,
     topic_name,
     qos_policies,
@@ -265,6 +267,31 @@ rmw_api_connextdds_take_with_info(
   return rc;
 }
 
+rmw_ret_t
+rmw_api_connextdds_subscription_set_message_info_fields(
+  const rmw_subscription_t * subscription,
+  const uint32_t fields)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription,
+    subscription->implementation_identifier,
+    RMW_CONNEXTDDS_ID,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  if (fields & ~static_cast<uint32_t>(RMW_CONNEXT_MESSAGE_INFO_ALL)) {
+    RMW_CONNEXT_LOG_ERROR_A_SET("invalid message info fields: 0x%x", fields)
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  RMW_Connext_Subscriber * const sub_impl =
+    reinterpret_cast<RMW_Connext_Subscriber *>(subscription->data);
+
+  sub_impl->message_info_fields(fields);
+
+  return RMW_RET_OK;
+}
+
 #if RMW_CONNEXT_HAVE_TAKE_SEQ
 
 
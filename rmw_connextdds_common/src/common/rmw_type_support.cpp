@@ -13,12 +13,17 @@
 // limitations under the License.
 
 #include <string.h>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "rmw_connextdds/type_support.hpp"
 
 #include "rmw_connextdds/rmw_impl.hpp"
 
+#include "rosidl_runtime_c/string.h"
+#include "rosidl_runtime_c/u16string.h"
+
 
 /******************************************************************************
  * RMW_Connext_MessageTypeSupport
@@ -27,15 +32,24 @@
 RMW_Connext_MessageTypeSupport::RMW_Connext_MessageTypeSupport(
   const RMW_Connext_MessageType message_type,
   const rosidl_message_type_support_t * const type_supports,
-  const char * const type_name)
+  const char * const type_name,
+  rmw_context_impl_t * const ctx,
+  const void * const intro_members,
+  const bool intro_members_cpp)
 : _type_support_fastrtps(
     RMW_Connext_MessageTypeSupport::get_type_support_fastrtps(
       type_supports)),
   _unbounded(false),
+  _bounds_declared(false),
+  _max_string(-1),
+  _max_sequence(-1),
+  _bounds_members(nullptr),
+  _bounds_members_cpp(false),
   _empty(false),
   _serialized_size_max(0),
   _type_name(),
-  _message_type(message_type)
+  _message_type(message_type),
+  _type_hash(0)
 {
   if (this->_type_support_fastrtps == nullptr) {
     throw std::runtime_error("FastRTPS type support not found");
@@ -66,10 +80,30 @@ RMW_Connext_MessageTypeSupport::RMW_Connext_MessageTypeSupport(
     this->_unbounded,
     this->_empty);
 
+  if (this->_unbounded && !this->_empty && nullptr != ctx) {
+    this->apply_type_bounds(
+      ctx, type_supports, intro_members, intro_members_cpp);
+  }
+
 #if RMW_CONNEXT_EMULATE_REQUESTREPLY
   if (!this->unbounded() && this->type_requestreply()) {
     /* Add request header to the serialized buffer */
     this->_serialized_size_max += RMW_GID_STORAGE_SIZE + sizeof(int64_t);
+#if RMW_CONNEXT_HAVE_REQUEST_TARGET
+    if (this->type_request()) {
+      this->_serialized_size_max += RMW_GID_STORAGE_SIZE;
+    }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_TARGET */
+#if RMW_CONNEXT_HAVE_REQUEST_PRIORITY
+    if (this->type_request()) {
+      this->_serialized_size_max += 2 * sizeof(int32_t);
+    }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_PRIORITY */
+#if RMW_CONNEXT_HAVE_REPLY_STREAM
+    if (!this->type_request()) {
+      this->_serialized_size_max += 2 * sizeof(int32_t);
+    }
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
   }
 #endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
 
@@ -135,10 +169,48 @@ rmw_ret_t RMW_Connext_MessageTypeSupport::serialize(
       }
 
       cdr_stream << rr_msg->sn;
+
+#if RMW_CONNEXT_HAVE_REQUEST_TARGET
+      if (this->type_request()) {
+        for (size_t i = 0; i < RMW_GID_STORAGE_SIZE; i++) {
+          cdr_stream << rr_msg->target.data[i];
+        }
+      }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_TARGET */
+
+#if RMW_CONNEXT_HAVE_REQUEST_PRIORITY
+      if (this->type_request()) {
+        /* The priority is padded to 8 bytes, so that the payload keeps
+           the same alignment */
+        const int32_t reserved = 0;
+        cdr_stream << rr_msg->priority;
+        cdr_stream << reserved;
+      }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_PRIORITY */
+
+#if RMW_CONNEXT_HAVE_REPLY_STREAM
+      if (!this->type_request()) {
+        /* The flags are padded to 8 bytes, so that the payload keeps
+           the same alignment */
+        const int32_t flags =
+          rr_msg->intermediate ? REPLY_FLAG_INTERMEDIATE : 0;
+        const int32_t reserved = 0;
+        cdr_stream << flags;
+        cdr_stream << reserved;
+      }
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
 #endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY  */
     }
 
     if (!this->_empty) {
+      /* The buffer of a type with declared bounds is sized for them, so
+         check every member before serializing it, rather than only
+         detecting a sample too large for the buffer */
+      if (this->_bounds_declared &&
+        RMW_RET_OK != this->check_type_bounds(payload))
+      {
+        return RMW_RET_ERROR;
+      }
       try {
         if (!callbacks->cdr_serialize(payload, cdr_stream)) {
           return RMW_RET_ERROR;
@@ -226,6 +298,32 @@ RMW_Connext_MessageTypeSupport::deserialize(
         cdr_stream >> rr_msg->gid.data[i];
       }
       cdr_stream >> rr_msg->sn;
+
+#if RMW_CONNEXT_HAVE_REQUEST_TARGET
+      if (this->type_request()) {
+        for (size_t i = 0; i < RMW_GID_STORAGE_SIZE; i++) {
+          cdr_stream >> rr_msg->target.data[i];
+        }
+      }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_TARGET */
+
+#if RMW_CONNEXT_HAVE_REQUEST_PRIORITY
+      if (this->type_request()) {
+        int32_t reserved = 0;
+        cdr_stream >> rr_msg->priority;
+        cdr_stream >> reserved;
+      }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_PRIORITY */
+
+#if RMW_CONNEXT_HAVE_REPLY_STREAM
+      if (!this->type_request()) {
+        int32_t flags = 0,
+          reserved = 0;
+        cdr_stream >> flags;
+        cdr_stream >> reserved;
+        rr_msg->intermediate = (flags & REPLY_FLAG_INTERMEDIATE) != 0;
+      }
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
 #endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
     }
 
@@ -302,6 +400,21 @@ uint32_t RMW_Connext_MessageTypeSupport::serialized_size_max(
     if (this->type_requestreply()) {
       /* Add request header to serialized payload */
       serialized_size += RMW_GID_STORAGE_SIZE + sizeof(int64_t);
+#if RMW_CONNEXT_HAVE_REQUEST_TARGET
+      if (this->type_request()) {
+        serialized_size += RMW_GID_STORAGE_SIZE;
+      }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_TARGET */
+#if RMW_CONNEXT_HAVE_REQUEST_PRIORITY
+      if (this->type_request()) {
+        serialized_size += 2 * sizeof(int32_t);
+      }
+#endif /* RMW_CONNEXT_HAVE_REQUEST_PRIORITY */
+#if RMW_CONNEXT_HAVE_REPLY_STREAM
+      if (!this->type_request()) {
+        serialized_size += 2 * sizeof(int32_t);
+      }
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
     }
 #endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
     RMW_CONNEXT_LOG_DEBUG_A(
@@ -360,7 +473,8 @@ RMW_Connext_MessageTypeSupport::register_type_support(
   const bool intro_members_cpp,
   std::string * const type_name)
 {
-  return rmw_connextdds_register_type_support(
+  RMW_Connext_MessageTypeSupport * const type_support =
+    rmw_connextdds_register_type_support(
     ctx,
     type_supports,
     participant,
@@ -369,16 +483,553 @@ RMW_Connext_MessageTypeSupport::register_type_support(
     intro_members,
     intro_members_cpp,
     (nullptr != type_name) ? type_name->c_str() : nullptr);
+
+#if RMW_CONNEXT_TYPE_HASH
+  if (nullptr != type_support) {
+    type_support->_type_hash =
+      RMW_Connext_MessageTypeSupport::compute_type_hash(
+      type_supports, intro_members, intro_members_cpp);
+    if (RMW_RET_OK != rmw_connextdds_assert_type_hash(ctx, type_support)) {
+      RMW_CONNEXT_LOG_WARNING_A(
+        "failed to check type hash: %s", type_support->type_name())
+    }
+  }
+#endif /* RMW_CONNEXT_TYPE_HASH */
+
+  return type_support;
+}
+
+#if RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+/* 64-bit FNV-1a hash */
+#define RMW_CONNEXT_FNV_OFFSET_BASIS    0xcbf29ce484222325ULL
+#define RMW_CONNEXT_FNV_PRIME           0x100000001b3ULL
+
+static
+void
+rmw_connextdds_hash_bytes(
+  uint64_t & hash, const void * const data, const size_t data_len)
+{
+  const uint8_t * const bytes = reinterpret_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < data_len; i++) {
+    hash ^= bytes[i];
+    hash *= RMW_CONNEXT_FNV_PRIME;
+  }
+}
+
+static
+void
+rmw_connextdds_hash_value(uint64_t & hash, const uint64_t value)
+{
+  // Hash values in a fixed byte order, so that hashes don't depend on the
+  // host's endianness.
+  uint8_t value_bytes[sizeof(value)];
+  for (size_t i = 0; i < sizeof(value); i++) {
+    value_bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+  rmw_connextdds_hash_bytes(hash, value_bytes, sizeof(value_bytes));
+}
+
+/* Hash the name, type and bounds of each member, recursing into nested
+   types. The same structure produces the same hash with both the C and
+   the C++ introspection type supports. */
+template<typename MembersType>
+static
+rmw_ret_t
+rmw_connextdds_hash_type_members(
+  uint64_t & hash, const MembersType * const members)
+{
+  rmw_connextdds_hash_value(hash, members->member_count_);
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * const member = members->members_ + i;
+    rmw_connextdds_hash_bytes(hash, member->name_, strlen(member->name_) + 1);
+    rmw_connextdds_hash_value(hash, member->type_id_);
+    rmw_connextdds_hash_value(hash, member->is_array_);
+    rmw_connextdds_hash_value(hash, member->array_size_);
+    rmw_connextdds_hash_value(hash, member->is_upper_bound_);
+    rmw_connextdds_hash_value(hash, member->string_upper_bound_);
+
+    if (::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE !=
+      member->type_id_)
+    {
+      continue;
+    }
+
+    bool cpp_version = false;
+    const rosidl_message_type_support_t * const type_support_intro =
+      RMW_Connext_MessageTypeSupport::get_type_support_intro(
+      member->members_, cpp_version);
+    if (nullptr == type_support_intro) {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "introspection type support not found for member: %s",
+        member->name_)
+      return RMW_RET_ERROR;
+    }
+
+    rmw_ret_t rc = RMW_RET_ERROR;
+    if (cpp_version) {
+      rc = rmw_connextdds_hash_type_members(
+        hash,
+        reinterpret_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+          type_support_intro->data));
+    } else {
+      rc = rmw_connextdds_hash_type_members(
+        hash,
+        reinterpret_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+          type_support_intro->data));
+    }
+    if (RMW_RET_OK != rc) {
+      return rc;
+    }
+  }
+  return RMW_RET_OK;
+}
+#endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
+
+uint64_t
+RMW_Connext_MessageTypeSupport::compute_type_hash(
+  const rosidl_message_type_support_t * const type_supports,
+  const void * const intro_members_in,
+  const bool intro_members_cpp)
+{
+#if RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+  bool cpp_version = intro_members_cpp;
+  const void * intro_members = intro_members_in;
+  if (nullptr == intro_members) {
+    const rosidl_message_type_support_t * const intro_ts =
+      RMW_Connext_MessageTypeSupport::get_type_support_intro(
+      type_supports, cpp_version);
+    if (nullptr == intro_ts) {
+      return 0;
+    }
+    intro_members = intro_ts->data;
+  }
+
+  // Introspection members are static, so they identify the type.
+  static std::mutex cache_mutex;
+  static std::map<const void *, uint64_t> cache;
+
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  auto cached = cache.find(intro_members);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+
+  uint64_t hash = RMW_CONNEXT_FNV_OFFSET_BASIS;
+  rmw_ret_t rc = RMW_RET_ERROR;
+  if (cpp_version) {
+    rc = rmw_connextdds_hash_type_members(
+      hash,
+      reinterpret_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+        intro_members));
+  } else {
+    rc = rmw_connextdds_hash_type_members(
+      hash,
+      reinterpret_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+        intro_members));
+  }
+  if (RMW_RET_OK != rc) {
+    return 0;
+  }
+  if (0 == hash) {
+    // 0 is reserved for "unknown"
+    hash = RMW_CONNEXT_FNV_OFFSET_BASIS;
+  }
+
+  try {
+    cache.emplace(intro_members, hash);
+  } catch (const std::exception &) {
+    // The hash will simply be computed again.
+  }
+  return hash;
+#else
+  UNUSED_ARG(type_supports);
+  UNUSED_ARG(intro_members_in);
+  UNUSED_ARG(intro_members_cpp);
+  return 0;
+#endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
+}
+
+#if RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+/* Padding required to align a CDR value of size `align` at an offset */
+static
+size_t
+rmw_connextdds_cdr_padding(const size_t offset, const size_t align)
+{
+  return (align - (offset % align)) & (align - 1);
+}
+
+static
+size_t
+rmw_connextdds_cdr_primitive_size(const uint8_t type_id)
+{
+  switch (type_id) {
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+      {
+        return 1;
+      }
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+      {
+        return 2;
+      }
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+      {
+        return 4;
+      }
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+      {
+        return 8;
+      }
+    default:
+      {
+        // Other types (e.g. long double, wchar) are never considered bounded.
+        return 0;
+      }
+  }
+}
+
+/* Compute the max CDR serialized size of a type, using the declared bounds
+   for its unbounded strings and sequences, and advance `offset` by it.
+   Returns false if the type contains an unbounded member which isn't covered
+   by the bounds, or if the size doesn't fit in 32 bits. */
+template<typename MembersType>
+static
+bool
+rmw_connextdds_bounded_size_max(
+  const MembersType * const members,
+  const RMW_Connext_TypeBounds & bounds,
+  size_t & offset)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * const member = members->members_ + i;
+
+    size_t count = 1;
+    if (member->is_array_) {
+      if (member->array_size_ > 0 && !member->is_upper_bound_) {
+        count = member->array_size_;
+      } else {
+        if (member->is_upper_bound_) {
+          count = member->array_size_;
+        } else if (bounds.max_sequence >= 0) {
+          count = static_cast<size_t>(bounds.max_sequence);
+        } else {
+          return false;
+        }
+        /* sequence length */
+        offset += rmw_connextdds_cdr_padding(offset, 4) + 4;
+      }
+    }
+
+    switch (member->type_id_) {
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
+        {
+          size_t str_len = member->string_upper_bound_;
+          if (0 == str_len) {
+            if (bounds.max_string < 0) {
+              return false;
+            }
+            str_len = static_cast<size_t>(bounds.max_string);
+          }
+          const size_t char_size =
+            (::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING ==
+            member->type_id_) ? 4 : 1;
+          /* Every string is 4-byte aligned: length, characters and
+             terminator, padded to the next string */
+          const size_t str_size = 4 + char_size * (str_len + 1);
+          offset += rmw_connextdds_cdr_padding(offset, 4) +
+            count * (str_size + rmw_connextdds_cdr_padding(str_size, 4));
+          break;
+        }
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
+        {
+          bool cpp_version = false;
+          const rosidl_message_type_support_t * const type_support_intro =
+            RMW_Connext_MessageTypeSupport::get_type_support_intro(
+            member->members_, cpp_version);
+          if (nullptr == type_support_intro) {
+            return false;
+          }
+          for (size_t j = 0; j < count; j++) {
+            bool bounded = false;
+            if (cpp_version) {
+              bounded = rmw_connextdds_bounded_size_max(
+                reinterpret_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+                  type_support_intro->data), bounds, offset);
+            } else {
+              bounded = rmw_connextdds_bounded_size_max(
+                reinterpret_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+                  type_support_intro->data), bounds, offset);
+            }
+            if (!bounded) {
+              return false;
+            }
+          }
+          break;
+        }
+      default:
+        {
+          const size_t size = rmw_connextdds_cdr_primitive_size(member->type_id_);
+          if (0 == size) {
+            return false;
+          }
+          if (count > 0) {
+            offset += rmw_connextdds_cdr_padding(offset, size) + count * size;
+          }
+          break;
+        }
+    }
+
+    if (offset > UINT32_MAX) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static
+size_t
+rmw_connextdds_string_length(
+  const rosidl_typesupport_introspection_cpp::MessageMember * const member,
+  const void * const value)
+{
+  if (::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING ==
+    member->type_id_)
+  {
+    return static_cast<const std::u16string *>(value)->size();
+  }
+  return static_cast<const std::string *>(value)->size();
+}
+
+static
+size_t
+rmw_connextdds_string_length(
+  const rosidl_typesupport_introspection_c__MessageMember * const member,
+  const void * const value)
+{
+  if (::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING ==
+    member->type_id_)
+  {
+    return static_cast<const rosidl_runtime_c__U16String *>(value)->size;
+  }
+  return static_cast<const rosidl_runtime_c__String *>(value)->size;
+}
+
+/* Check the length of every unbounded string and sequence of a sample
+   against the declared bounds. Returns false, and the (dotted) name of
+   the first member out of bounds, if any exceeds them. */
+template<typename MembersType>
+static
+bool
+rmw_connextdds_check_bounds(
+  const MembersType * const members,
+  const int32_t max_string,
+  const int32_t max_sequence,
+  const void * const ros_msg,
+  std::string & member_name)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * const member = members->members_ + i;
+    const void * const value =
+      static_cast<const uint8_t *>(ros_msg) + member->offset_;
+
+    const bool is_string =
+      ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING ==
+      member->type_id_ ||
+      ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING ==
+      member->type_id_;
+    const bool is_message =
+      ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE ==
+      member->type_id_;
+
+    size_t count = 1;
+    if (member->is_array_) {
+      count = (nullptr != member->size_function) ?
+        member->size_function(value) : member->array_size_;
+      if (0 == member->array_size_ && !member->is_upper_bound_ &&
+        max_sequence >= 0 && count > static_cast<size_t>(max_sequence))
+      {
+        member_name = member->name_;
+        return false;
+      }
+    }
+
+    if ((!is_string || 0 != member->string_upper_bound_) && !is_message) {
+      continue;
+    }
+
+    const rosidl_message_type_support_t * type_support_intro = nullptr;
+    bool cpp_version = false;
+    if (is_message) {
+      type_support_intro =
+        RMW_Connext_MessageTypeSupport::get_type_support_intro(
+        member->members_, cpp_version);
+      if (nullptr == type_support_intro) {
+        continue;
+      }
+    }
+
+    for (size_t j = 0; j < count; j++) {
+      const void * const element = (member->is_array_) ?
+        member->get_const_function(value, j) : value;
+      bool in_bounds = true;
+      std::string nested_name;
+      if (is_string) {
+        in_bounds = max_string < 0 ||
+          rmw_connextdds_string_length(member, element) <=
+          static_cast<size_t>(max_string);
+      } else if (cpp_version) {
+        in_bounds = rmw_connextdds_check_bounds(
+          reinterpret_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+            type_support_intro->data),
+          max_string, max_sequence, element, nested_name);
+      } else {
+        in_bounds = rmw_connextdds_check_bounds(
+          reinterpret_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+            type_support_intro->data),
+          max_string, max_sequence, element, nested_name);
+      }
+      if (!in_bounds) {
+        member_name = member->name_;
+        if (!nested_name.empty()) {
+          member_name += "." + nested_name;
+        }
+        return false;
+      }
+    }
+  }
+  return true;
+}
+#endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
+
+rmw_ret_t
+RMW_Connext_MessageTypeSupport::check_type_bounds(const void * const ros_msg)
+{
+#if RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+  std::string member_name;
+  bool in_bounds = true;
+  if (this->_bounds_members_cpp) {
+    in_bounds = rmw_connextdds_check_bounds(
+      reinterpret_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+        this->_bounds_members),
+      this->_max_string, this->_max_sequence, ros_msg, member_name);
+  } else {
+    in_bounds = rmw_connextdds_check_bounds(
+      reinterpret_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+        this->_bounds_members),
+      this->_max_string, this->_max_sequence, ros_msg, member_name);
+  }
+  if (!in_bounds) {
+    RMW_CONNEXT_LOG_ERROR_A_SET(
+      "Failed to serialize data: member %s exceeds the bounds declared "
+      "for type %s (max_string=%d, max_sequence=%d)",
+      member_name.c_str(), this->type_name(),
+      this->_max_string, this->_max_sequence)
+    return RMW_RET_ERROR;
+  }
+  return RMW_RET_OK;
+#else
+  UNUSED_ARG(ros_msg);
+  return RMW_RET_OK;
+#endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
+}
+
+void
+RMW_Connext_MessageTypeSupport::apply_type_bounds(
+  rmw_context_impl_t * const ctx,
+  const rosidl_message_type_support_t * const type_supports,
+  const void * const intro_members_in,
+  const bool intro_members_cpp)
+{
+  const RMW_Connext_TypeBounds * bounds = nullptr;
+  for (const auto & type_bounds : ctx->type_bounds) {
+    if (rmw_connextdds_match_pattern(
+        type_bounds.pattern.c_str(), this->type_name()))
+    {
+      bounds = &type_bounds;
+      break;
+    }
+  }
+  if (nullptr == bounds) {
+    return;
+  }
+
+#if RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+  bool cpp_version = intro_members_cpp;
+  const void * intro_members = intro_members_in;
+  if (nullptr == intro_members) {
+    const rosidl_message_type_support_t * const intro_ts =
+      RMW_Connext_MessageTypeSupport::get_type_support_intro(
+      type_supports, cpp_version);
+    if (nullptr != intro_ts) {
+      intro_members = intro_ts->data;
+    }
+  }
+
+  size_t size_max = 0;
+  bool bounded = false;
+  if (nullptr != intro_members) {
+    if (cpp_version) {
+      bounded = rmw_connextdds_bounded_size_max(
+        reinterpret_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+          intro_members), *bounds, size_max);
+    } else {
+      bounded = rmw_connextdds_bounded_size_max(
+        reinterpret_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+          intro_members), *bounds, size_max);
+    }
+  }
+
+  if (!bounded || size_max + ENCAPSULATION_HEADER_SIZE > UINT32_MAX) {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "declared bounds don't cover all unbounded members of type %s, "
+      "handling it as unbounded", this->type_name())
+    return;
+  }
+
+  this->_serialized_size_max =
+    static_cast<uint32_t>(size_max) + ENCAPSULATION_HEADER_SIZE;
+  this->_unbounded = false;
+  this->_bounds_declared = true;
+  this->_max_string = bounds->max_string;
+  this->_max_sequence = bounds->max_sequence;
+  this->_bounds_members = intro_members;
+  this->_bounds_members_cpp = cpp_version;
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "[type support] %s bounded by declaration: "
+    "max_string=%d, max_sequence=%d, serialized_size_max=%u",
+    this->type_name(),
+    bounds->max_string,
+    bounds->max_sequence,
+    this->_serialized_size_max)
+#else
+  UNUSED_ARG(type_supports);
+  UNUSED_ARG(intro_members_in);
+  UNUSED_ARG(intro_members_cpp);
+  RMW_CONNEXT_LOG_WARNING_A(
+    "declared bounds require introspection type support, "
+    "handling type %s as unbounded", this->type_name())
+#endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
 }
 
 rmw_ret_t
 RMW_Connext_MessageTypeSupport::unregister_type_support(
   rmw_context_impl_t * const ctx,
   DDS_DomainParticipant * const participant,
-  const char * const type_name)
+  const char * const type_name,
+  const bool keep_registered)
 {
   return rmw_connextdds_unregister_type_support(
-    ctx, participant, type_name);
+    ctx, participant, type_name, keep_registered);
 }
 
 void RMW_Connext_MessageTypeSupport::type_info(
@@ -0,0 +1,104 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_connextdds/worker_pool.hpp"
+
+RMW_Connext_WorkerPool::RMW_Connext_WorkerPool(const size_t threads_len)
+{
+  this->threads.reserve(threads_len);
+  try {
+    for (size_t i = 0; i < threads_len; i++) {
+      this->threads.emplace_back(&RMW_Connext_WorkerPool::worker_main, this);
+    }
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stopping = true;
+    }
+    this->cond_work.notify_all();
+    for (auto & thread : this->threads) {
+      thread.join();
+    }
+    throw;
+  }
+}
+
+RMW_Connext_WorkerPool::~RMW_Connext_WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->cond_work.notify_all();
+  for (auto & thread : this->threads) {
+    thread.join();
+  }
+}
+
+void
+RMW_Connext_WorkerPool::run(const size_t jobs_len, const Job & job)
+{
+  std::lock_guard<std::mutex> run_lock(this->run_mutex);
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->job = &job;
+  this->jobs_len = jobs_len;
+  this->jobs_next = 0;
+  this->jobs_done = 0;
+  this->cond_work.notify_all();
+
+  this->run_jobs(lock);
+
+  this->cond_done.wait(
+    lock, [this]() {return this->jobs_done == this->jobs_len;});
+  this->job = nullptr;
+  this->jobs_len = 0;
+}
+
+void
+RMW_Connext_WorkerPool::run_jobs(std::unique_lock<std::mutex> & lock)
+{
+  while (nullptr != this->job && this->jobs_next < this->jobs_len) {
+    const Job & job = *this->job;
+    const size_t i = this->jobs_next;
+    this->jobs_next += 1;
+
+    lock.unlock();
+    job(i);
+    lock.lock();
+
+    this->jobs_done += 1;
+    if (this->jobs_done == this->jobs_len) {
+      this->cond_done.notify_all();
+    }
+  }
+}
+
+void
+RMW_Connext_WorkerPool::worker_main()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true) {
+    this->cond_work.wait(
+      lock,
+      [this]() {
+        return this->stopping ||
+        (nullptr != this->job && this->jobs_next < this->jobs_len);
+      });
+    if (this->stopping) {
+      return;
+    }
+    this->run_jobs(lock);
+  }
+}
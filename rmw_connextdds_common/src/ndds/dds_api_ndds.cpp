@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include "rmw/impl/cpp/key_value.hpp"
@@ -133,6 +136,28 @@ rmw_connextdds_initialize_participant_qos_impl(
   dp_qos->database.shutdown_cleanup_period.sec = 0;
   dp_qos->database.shutdown_cleanup_period.nanosec = 50000000;
 
+  // Let writers' transport priority set the DSCP bits of the IP TOS field
+  // of outgoing UDPv4 packets, unless a mask was configured by the user.
+  static const char * const priority_mask_property =
+    "dds.transport.UDPv4.builtin.transport_priority_mask";
+  if (nullptr ==
+    DDS_PropertyQosPolicyHelper_lookup_property(
+      &dp_qos->property, priority_mask_property))
+  {
+    if (DDS_RETCODE_OK !=
+      DDS_PropertyQosPolicyHelper_add_property(
+        &dp_qos->property,
+        priority_mask_property,
+        "0xfc",
+        DDS_BOOLEAN_FALSE /* propagate */))
+    {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "failed to assert property on participant: %s",
+        priority_mask_property)
+      return RMW_RET_ERROR;
+    }
+  }
+
   if (ctx->localhost_only) {
     if (DDS_RETCODE_OK !=
       DDS_PropertyQosPolicyHelper_assert_property(
@@ -166,10 +191,10 @@ rmw_connextdds_initialize_participant_qos_impl(
 
 #if RMW_CONNEXT_HAVE_OPTIONS
   const char * const user_data_fmt = "enclave=%s;";
+  const char * const enclave = ctx->base.load()->options.enclave;
 
   const int user_data_len =
-    std::snprintf(
-    nullptr, 0, user_data_fmt, ctx->base->options.enclave) + 1;
+    std::snprintf(nullptr, 0, user_data_fmt, enclave) + 1;
 
   if (!DDS_OctetSeq_ensure_length(
       &dp_qos->user_data.value, user_data_len, user_data_len))
@@ -187,7 +212,7 @@ rmw_connextdds_initialize_participant_qos_impl(
     user_data_ptr,
     user_data_len,
     user_data_fmt,
-    ctx->base->options.enclave);
+    enclave);
 
   if (user_data_rc < 0 || user_data_rc != user_data_len - 1) {
     RMW_CONNEXT_LOG_ERROR_SET("failed to set user_data")
@@ -337,6 +362,309 @@ rmw_connextdds_get_qos_policies(
   return RMW_RET_OK;
 }
 
+/* Configure the token bucket of a flow controller for the specified rate
+   (bytes/s, 0 for unlimited) and burst size (bytes, 0 for the default). */
+static
+void
+rmw_connextdds_flow_controller_property(
+  const uint64_t rate,
+  const uint64_t burst,
+  DDS_FlowControllerProperty_t * const property)
+{
+  DDS_FlowControllerTokenBucketProperty_t * const token_bucket =
+    &property->token_bucket;
+
+  token_bucket->period.sec =
+    static_cast<DDS_Long>(RMW_CONNEXT_FLOW_CONTROLLER_PERIOD_MS / 1000);
+  token_bucket->period.nanosec =
+    static_cast<DDS_UnsignedLong>(
+    (RMW_CONNEXT_FLOW_CONTROLLER_PERIOD_MS % 1000) * 1000000);
+  token_bucket->bytes_per_token = RMW_CONNEXT_FLOW_CONTROLLER_BYTES_PER_TOKEN;
+  // Accumulate unused tokens, up to the burst size
+  token_bucket->tokens_leaked_per_period = 0;
+
+  if (0 == rate) {
+    token_bucket->tokens_added_per_period = DDS_LENGTH_UNLIMITED;
+    token_bucket->max_tokens = DDS_LENGTH_UNLIMITED;
+    return;
+  }
+
+  const uint64_t token_size = RMW_CONNEXT_FLOW_CONTROLLER_BYTES_PER_TOKEN;
+  const uint64_t period_bytes =
+    rate * RMW_CONNEXT_FLOW_CONTROLLER_PERIOD_MS / 1000;
+  const uint64_t burst_bytes =
+    (0 != burst) ? burst : RMW_CONNEXT_FLOW_CONTROLLER_BURST_DEFAULT;
+  const uint64_t tokens_added =
+    std::max<uint64_t>(1, (period_bytes + token_size - 1) / token_size);
+  const uint64_t max_tokens = std::max<uint64_t>(
+    tokens_added, (burst_bytes + token_size - 1) / token_size);
+
+  token_bucket->tokens_added_per_period =
+    static_cast<DDS_Long>(std::min<uint64_t>(tokens_added, INT32_MAX));
+  token_bucket->max_tokens =
+    static_cast<DDS_Long>(std::min<uint64_t>(max_tokens, INT32_MAX));
+}
+
+/* Attach a writer to a token-bucket flow controller, if a rate was
+   configured for it. Flow controllers are shared by name, and created in
+   the writer's participant the first time they are used. Writers which
+   request a different rate or burst size for an existing controller are
+   rejected, rather than silently inheriting the first writer's settings. */
+static
+rmw_ret_t
+rmw_connextdds_configure_flow_controller(
+  DDS_Topic * const topic,
+  DDS_DataWriterQos * const qos,
+  const RMW_Connext_QosOverride * const qos_override
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  ,
+  const rmw_publisher_options_t * const pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+)
+{
+  uint64_t rate = 0;
+  uint64_t burst = 0;
+
+  if (nullptr != qos_override) {
+    if (qos_override->flow_rate > 0) {
+      rate = static_cast<uint64_t>(qos_override->flow_rate);
+    }
+    if (qos_override->flow_burst > 0) {
+      burst = static_cast<uint64_t>(qos_override->flow_burst);
+    }
+  }
+
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  if (nullptr != pub_options &&
+    nullptr != pub_options->rmw_specific_publisher_payload)
+  {
+    const rmw_connextdds_publisher_options_t * const opts =
+      static_cast<const rmw_connextdds_publisher_options_t *>(
+      pub_options->rmw_specific_publisher_payload);
+    if (0 != opts->flow_rate) {
+      rate = opts->flow_rate;
+    }
+    if (0 != opts->flow_burst) {
+      burst = opts->flow_burst;
+    }
+  }
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+
+  if (0 == rate) {
+    return RMW_RET_OK;
+  }
+
+  DDS_TopicDescription * const topic_desc =
+    DDS_Topic_as_topicdescription(topic);
+  const std::string fc_name =
+    (nullptr != qos_override && !qos_override->flow_controller.empty()) ?
+    qos_override->flow_controller :
+    std::string(RMW_CONNEXT_FLOW_CONTROLLER_PREFIX) +
+    DDS_TopicDescription_get_name(topic_desc);
+
+  DDS_DomainParticipant * const dp =
+    DDS_TopicDescription_get_participant(topic_desc);
+
+  DDS_FlowController * const fc =
+    DDS_DomainParticipant_lookup_flowcontroller(dp, fc_name.c_str());
+  if (nullptr != fc) {
+    // The controller is shared with other writers: only attach to it if
+    // it was configured with the same rate and burst size.
+    struct DDS_FlowControllerProperty_t fc_property;
+    if (DDS_RETCODE_OK != DDS_FlowController_get_property(fc, &fc_property)) {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to get flow controller property")
+      return RMW_RET_ERROR;
+    }
+    struct DDS_FlowControllerProperty_t req_property = fc_property;
+    rmw_connextdds_flow_controller_property(rate, burst, &req_property);
+
+    const DDS_FlowControllerTokenBucketProperty_t * const tb =
+      &fc_property.token_bucket;
+    const DDS_FlowControllerTokenBucketProperty_t * const req_tb =
+      &req_property.token_bucket;
+    if (tb->max_tokens != req_tb->max_tokens ||
+      tb->tokens_added_per_period != req_tb->tokens_added_per_period ||
+      tb->tokens_leaked_per_period != req_tb->tokens_leaked_per_period ||
+      tb->bytes_per_token != req_tb->bytes_per_token ||
+      tb->period.sec != req_tb->period.sec ||
+      tb->period.nanosec != req_tb->period.nanosec)
+    {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "flow controller already exists with a different configuration: "
+        "name=%s, rate=%lu, burst=%lu",
+        fc_name.c_str(), rate, burst)
+      return RMW_RET_ERROR;
+    }
+  } else {
+    struct DDS_FlowControllerProperty_t fc_property;
+    if (DDS_RETCODE_OK !=
+      DDS_DomainParticipant_get_default_flowcontroller_property(
+        dp, &fc_property))
+    {
+      RMW_CONNEXT_LOG_ERROR_SET(
+        "failed to get default flow controller property")
+      return RMW_RET_ERROR;
+    }
+
+    rmw_connextdds_flow_controller_property(rate, burst, &fc_property);
+
+    if (nullptr ==
+      DDS_DomainParticipant_create_flowcontroller(
+        dp, fc_name.c_str(), &fc_property))
+    {
+      RMW_CONNEXT_LOG_ERROR_A_SET(
+        "failed to create flow controller: %s", fc_name.c_str())
+      return RMW_RET_ERROR;
+    }
+
+    RMW_CONNEXT_LOG_DEBUG_A(
+      "created flow controller: name=%s, rate=%lu, burst=%lu",
+      fc_name.c_str(), rate, burst)
+  }
+
+  if (nullptr ==
+    DDS_String_replace(
+      &qos->publish_mode.flow_controller_name, fc_name.c_str()))
+  {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to set writer's flow controller")
+    return RMW_RET_ERROR;
+  }
+
+  // Flow controllers only apply to asynchronous writers
+  qos->publish_mode.kind = DDS_ASYNCHRONOUS_PUBLISH_MODE_QOS;
+
+  return RMW_RET_OK;
+}
+
+static
+void
+rmw_connextdds_apply_writer_reliability_preset(
+  const RMW_Connext_QosOverride * const qos_override,
+  DDS_DataWriterQos * const qos)
+{
+  RMW_Connext_ReliabilityProtocol preset;
+  if (nullptr == qos_override ||
+    !rmw_connextdds_get_reliability_preset(
+      qos_override->reliability_preset, &preset))
+  {
+    return;
+  }
+
+  DDS_RtpsReliableWriterProtocol_t * const writer_protocol =
+    &qos->protocol.rtps_reliable_writer;
+
+  rmw_connextdds_duration_from_ms(
+    preset.heartbeat_period_ms, &writer_protocol->heartbeat_period);
+  rmw_connextdds_duration_from_ms(
+    preset.fast_heartbeat_period_ms, &writer_protocol->fast_heartbeat_period);
+  rmw_connextdds_duration_from_ms(
+    preset.fast_heartbeat_period_ms,
+    &writer_protocol->late_joiner_heartbeat_period);
+  rmw_connextdds_duration_from_ms(
+    0, &writer_protocol->min_nack_response_delay);
+  rmw_connextdds_duration_from_ms(
+    preset.nack_response_delay_ms, &writer_protocol->max_nack_response_delay);
+
+  // The send window (and the piggyback heartbeats sent within it) may not
+  // exceed the samples that the writer can keep in its queue.
+  int32_t send_window_max = preset.send_window_max;
+  int32_t heartbeats_per_max_samples = preset.heartbeats_per_max_samples;
+  if (DDS_LENGTH_UNLIMITED != qos->resource_limits.max_samples) {
+    if (send_window_max > qos->resource_limits.max_samples) {
+      send_window_max = qos->resource_limits.max_samples;
+    }
+    if (heartbeats_per_max_samples > qos->resource_limits.max_samples) {
+      heartbeats_per_max_samples = qos->resource_limits.max_samples;
+    }
+  }
+  writer_protocol->heartbeats_per_max_samples = heartbeats_per_max_samples;
+
+  if (send_window_max > 0) {
+    writer_protocol->min_send_window_size =
+      std::min(preset.send_window_min, send_window_max);
+    writer_protocol->max_send_window_size = send_window_max;
+  } else {
+    writer_protocol->min_send_window_size = DDS_LENGTH_UNLIMITED;
+    writer_protocol->max_send_window_size = DDS_LENGTH_UNLIMITED;
+  }
+}
+
+static
+void
+rmw_connextdds_apply_reader_reliability_preset(
+  const RMW_Connext_QosOverride * const qos_override,
+  DDS_DataReaderQos * const qos)
+{
+  RMW_Connext_ReliabilityProtocol preset;
+  if (nullptr == qos_override ||
+    !rmw_connextdds_get_reliability_preset(
+      qos_override->reliability_preset, &preset))
+  {
+    return;
+  }
+
+  DDS_RtpsReliableReaderProtocol_t * const reader_protocol =
+    &qos->protocol.rtps_reliable_reader;
+
+  rmw_connextdds_duration_from_ms(
+    0, &reader_protocol->min_heartbeat_response_delay);
+  rmw_connextdds_duration_from_ms(
+    preset.heartbeat_response_delay_ms,
+    &reader_protocol->max_heartbeat_response_delay);
+  rmw_connextdds_duration_from_ms(
+    preset.nack_period_ms, &reader_protocol->nack_period);
+}
+
+// Append an entry to any user data already set by the QoS profile
+static
+rmw_ret_t
+rmw_connextdds_append_user_data(
+  DDS_UserDataQosPolicy * const user_data,
+  const char * const entry,
+  const DDS_Long entry_len)
+{
+  const DDS_Long prev_len = DDS_OctetSeq_get_length(&user_data->value);
+  const DDS_Long user_data_len = prev_len + entry_len;
+  if (!DDS_OctetSeq_ensure_length(
+      &user_data->value, user_data_len, user_data_len))
+  {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to set user_data length")
+    return RMW_RET_ERROR;
+  }
+  memcpy(
+    DDS_OctetSeq_get_contiguous_buffer(&user_data->value) + prev_len,
+    entry, entry_len);
+
+  return RMW_RET_OK;
+}
+
+#if RMW_CONNEXT_TYPE_HASH
+// Advertise the hash of an endpoint's type in its user data, so that remote
+// participants may ignore it if their type has a different structure.
+static
+rmw_ret_t
+rmw_connextdds_set_type_hash_user_data(
+  RMW_Connext_MessageTypeSupport * const type_support,
+  DDS_UserDataQosPolicy * const user_data)
+{
+  if (0 == type_support->type_hash()) {
+    return RMW_RET_OK;
+  }
+
+  char entry[32];
+  const int entry_len =
+    std::snprintf(
+    entry, sizeof(entry), "typehash=%016llx;",
+    static_cast<unsigned long long>(type_support->type_hash()));  // NOLINT
+  if (entry_len < 0 || static_cast<size_t>(entry_len) >= sizeof(entry)) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to format type hash")
+    return RMW_RET_ERROR;
+  }
+
+  return rmw_connextdds_append_user_data(user_data, entry, entry_len);
+}
+#endif /* RMW_CONNEXT_TYPE_HASH */
+
 rmw_ret_t
 rmw_connextdds_get_datawriter_qos(
   rmw_context_impl_t * const ctx,
@@ -350,8 +678,11 @@ rmw_connextdds_get_datawriter_qos(
 #endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
 )
 {
-  UNUSED_ARG(ctx);
-  UNUSED_ARG(topic);
+  const RMW_Connext_QosOverride * const qos_override =
+    rmw_connextdds_find_qos_override(
+    ctx,
+    DDS_TopicDescription_get_name(DDS_Topic_as_topicdescription(topic)),
+    type_support->type_name());
 
   if (RMW_RET_OK !=
     rmw_connextdds_get_readerwriter_qos(
@@ -368,6 +699,7 @@ rmw_connextdds_get_datawriter_qos(
 #if RMW_CONNEXT_HAVE_LIFESPAN_QOS
       &qos->lifespan,
 #endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS */
+      qos_override,
       qos_policies
 #if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
       ,
@@ -379,7 +711,61 @@ rmw_connextdds_get_datawriter_qos(
     return RMW_RET_ERROR;
   }
 
-  qos->publish_mode.kind = DDS_ASYNCHRONOUS_PUBLISH_MODE_QOS;
+  rmw_ret_t rc = rmw_connextdds_get_writer_blocking_qos(
+    ctx,
+    &qos->reliability
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+    ,
+    pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  );
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
+  if (nullptr == qos_override || !qos_override->has_publish_mode) {
+    qos->publish_mode.kind = DDS_ASYNCHRONOUS_PUBLISH_MODE_QOS;
+  }
+
+  const int32_t transport_priority =
+    rmw_connextdds_get_writer_transport_priority(
+    qos_override
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+    ,
+    pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  );
+  if (0 != transport_priority) {
+    qos->transport_priority.value = transport_priority;
+  }
+
+  rc = rmw_connextdds_configure_flow_controller(
+    topic,
+    qos,
+    qos_override
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+    ,
+    pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  );
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
+  if (nullptr != qos_override && qos_override->batch_max_samples >= 0) {
+    qos->batch.enable =
+      (qos_override->batch_max_samples > 0) ? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE;
+    qos->batch.max_samples = qos_override->batch_max_samples;
+  }
+
+  rmw_connextdds_apply_writer_reliability_preset(qos_override, qos);
+
+#if RMW_CONNEXT_TYPE_HASH
+  rc = rmw_connextdds_set_type_hash_user_data(type_support, &qos->user_data);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+#endif /* RMW_CONNEXT_TYPE_HASH */
 
   return rmw_connextdds_get_qos_policies(
     true /* writer_qos */,
@@ -406,8 +792,17 @@ rmw_connextdds_get_datareader_qos(
 #endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
 )
 {
-  UNUSED_ARG(ctx);
-  UNUSED_ARG(topic_desc);
+  // Match content-filtered topics by the name of their related topic
+  DDS_ContentFilteredTopic * const cft_topic =
+    DDS_ContentFilteredTopic_narrow(topic_desc);
+  const char * const topic_name = (nullptr != cft_topic) ?
+    DDS_TopicDescription_get_name(
+    DDS_Topic_as_topicdescription(
+      DDS_ContentFilteredTopic_get_related_topic(cft_topic))) :
+    DDS_TopicDescription_get_name(topic_desc);
+  const RMW_Connext_QosOverride * const qos_override =
+    rmw_connextdds_find_qos_override(
+    ctx, topic_name, type_support->type_name());
 
   if (RMW_RET_OK !=
     rmw_connextdds_get_readerwriter_qos(
@@ -423,6 +818,7 @@ rmw_connextdds_get_datareader_qos(
 #if RMW_CONNEXT_HAVE_LIFESPAN_QOS
       nullptr /* Lifespan is a writer-only qos policy */,
 #endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS */
+      qos_override,
       qos_policies
 #if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
       ,
@@ -433,6 +829,17 @@ rmw_connextdds_get_datareader_qos(
   {
     return RMW_RET_ERROR;
   }
+
+  rmw_connextdds_apply_reader_reliability_preset(qos_override, qos);
+
+#if RMW_CONNEXT_TYPE_HASH
+  if (RMW_RET_OK !=
+    rmw_connextdds_set_type_hash_user_data(type_support, &qos->user_data))
+  {
+    return RMW_RET_ERROR;
+  }
+#endif /* RMW_CONNEXT_TYPE_HASH */
+
   return rmw_connextdds_get_qos_policies(
     false /* writer_qos */,
     type_support,
@@ -524,11 +931,14 @@ rmw_connextdds_write_message(
   RMW_Connext_Message * const message,
   int64_t * const sn_out)
 {
+  DDS_WriteParams_t write_params = DDS_WRITEPARAMS_DEFAULT;
+  bool use_params = false;
+
 #if !RMW_CONNEXT_EMULATE_REQUESTREPLY
   if (pub->message_type_support()->type_requestreply()) {
     const RMW_Connext_RequestReplyMessage * const rr_msg =
       reinterpret_cast<const RMW_Connext_RequestReplyMessage *>(message->user_data);
-    DDS_WriteParams_t write_params = DDS_WRITEPARAMS_DEFAULT;
+    use_params = true;
 
     if (!rr_msg->request) {
       /* If this is a reply, propagate the request's sample identity
@@ -545,50 +955,203 @@ rmw_connextdds_write_message(
       if (RMW_RET_OK != rc) {
         return rc;
       }
+
+      if (rr_msg->intermediate) {
+        /* More parts of the same response will follow */
+        write_params.flag |= DDS_INTERMEDIATE_REPLY_SEQUENCE_SAMPLE;
+      }
     } else {
-      // enable WriteParams::replace_auto to retrieve SN of published message
-      write_params.replace_auto = DDS_BOOLEAN_TRUE;
-    }
+      /* Use the SN assigned by the client, so that the request may be
+         tracked before it is written (and a reply received). */
+      rmw_connextdds_sn_ros_to_dds(
+        rr_msg->sn, write_params.identity.sequence_number);
 
-    if (DDS_RETCODE_OK !=
-      DDS_DataWriter_write_w_params_untypedI(
-        pub->writer(), message, &write_params))
-    {
-      RMW_CONNEXT_LOG_ERROR_SET(
-        "failed to write request/reply message to DDS")
-      return RMW_RET_ERROR;
+      rmw_ret_t rc = rmw_connextdds_gid_to_guid(
+        rr_msg->gid, write_params.identity.writer_guid);
+      if (RMW_RET_OK != rc) {
+        return rc;
+      }
     }
+  }
+#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
 
-    if (rr_msg->request) {
-      int64_t sn = 0;
-
-      // Read assigned sn from write_params
-      rmw_connextdds_sn_dds_to_ros(
-        write_params.identity.sequence_number, sn);
+  if (nullptr != sn_out) {
+    // enable WriteParams::replace_auto to retrieve SN of published message
+    use_params = true;
+    write_params.replace_auto = DDS_BOOLEAN_TRUE;
+  }
 
-      *sn_out = sn;
-    }
+  const DDS_ReturnCode_t rc = use_params ?
+    DDS_DataWriter_write_w_params_untypedI(
+    pub->writer(), message, &write_params) :
+    DDS_DataWriter_write_untypedI(pub->writer(), message, &DDS_HANDLE_NIL);
+  if (DDS_RETCODE_TIMEOUT == rc) {
+    RMW_SET_ERROR_MSG("timed out while writing message to DDS");
+    return RMW_RET_TIMEOUT;
+  } else if (DDS_RETCODE_OK != rc) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to write message to DDS")
+    return RMW_RET_ERROR;
+  }
 
-    return RMW_RET_OK;
+  if (nullptr != sn_out) {
+    rmw_connextdds_sn_dds_to_ros(
+      write_params.identity.sequence_number, *sn_out);
   }
+
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_set_flow_rate(
+  RMW_Connext_Publisher * const pub,
+  const uint64_t rate,
+  const uint64_t burst)
+{
+#if !RMW_CONNEXT_DDS_API_PRO_LEGACY
+  DDS_DataWriterQos dw_qos = DDS_DataWriterQos_INITIALIZER;
 #else
-  UNUSED_ARG(sn_out);
-#endif /* RMW_CONNEXT_EMULATE_REQUESTREPLY */
+  DDS_DataWriterQos dw_qos;
+  if (DDS_RETCODE_OK != DDS_DataWriterQos_initialize(&dw_qos)) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to initialize datawriter qos")
+    return RMW_RET_ERROR;
+  }
+#endif /* !RMW_CONNEXT_DDS_API_PRO_LEGACY */
 
-  if (DDS_RETCODE_OK !=
-    DDS_DataWriter_write_untypedI(
-      pub->writer(), message, &DDS_HANDLE_NIL))
+  DDS_DataWriterQos * const dw_qos_ptr = &dw_qos;
+  auto scope_exit_dw_qos_delete =
+    rcpputils::make_scope_exit(
+    [dw_qos_ptr]()
+    {
+      if (DDS_RETCODE_OK != DDS_DataWriterQos_finalize(dw_qos_ptr)) {
+        RMW_CONNEXT_LOG_ERROR_SET("failed to finalize DataWriterQoS")
+      }
+    });
+
+  if (DDS_RETCODE_OK != DDS_DataWriter_get_qos(pub->writer(), &dw_qos)) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get DataWriter's qos")
+    return RMW_RET_ERROR;
+  }
+
+  // Never modify the built-in flow controllers, which are shared by all
+  // asynchronous writers in the participant.
+  const char * const fc_name = dw_qos.publish_mode.flow_controller_name;
+  if (nullptr == fc_name ||
+    dw_qos.publish_mode.kind != DDS_ASYNCHRONOUS_PUBLISH_MODE_QOS ||
+    strcmp(fc_name, DDS_DEFAULT_FLOW_CONTROLLER_NAME) == 0 ||
+    strcmp(fc_name, DDS_FIXED_RATE_FLOW_CONTROLLER_NAME) == 0 ||
+    strcmp(fc_name, DDS_ON_DEMAND_FLOW_CONTROLLER_NAME) == 0)
   {
-    RMW_CONNEXT_LOG_ERROR_SET("failed to write message to DDS")
+    RMW_CONNEXT_LOG_ERROR_SET("publisher has no configurable flow controller")
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  DDS_FlowController * const fc =
+    DDS_DomainParticipant_lookup_flowcontroller(
+    pub->dds_participant(), fc_name);
+  if (nullptr == fc) {
+    RMW_CONNEXT_LOG_ERROR_A_SET("flow controller not found: %s", fc_name)
+    return RMW_RET_ERROR;
+  }
+
+  struct DDS_FlowControllerProperty_t fc_property;
+  if (DDS_RETCODE_OK != DDS_FlowController_get_property(fc, &fc_property)) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get flow controller property")
     return RMW_RET_ERROR;
   }
 
+  rmw_connextdds_flow_controller_property(rate, burst, &fc_property);
+
+  if (DDS_RETCODE_OK != DDS_FlowController_set_property(fc, &fc_property)) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to set flow controller property")
+    return RMW_RET_ERROR;
+  }
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "updated flow controller: name=%s, rate=%lu, burst=%lu",
+    fc_name, rate, burst)
+
   return RMW_RET_OK;
 }
 
+static
+void
+rmw_connextdds_gid_to_ih(const rmw_gid_t & gid, DDS_InstanceHandle_t & ih)
+{
+  ih = DDS_HANDLE_NIL;
+  memcpy(ih.keyHash.value, gid.data, MIG_RTPS_KEY_HASH_MAX_LENGTH);
+  ih.keyHash.length = MIG_RTPS_KEY_HASH_MAX_LENGTH;
+  ih.isValid = DDS_BOOLEAN_TRUE;
+}
+
+rmw_ret_t
+rmw_connextdds_wait_for_reply_acknowledgment(
+  RMW_Connext_Publisher * const pub,
+  const rmw_gid_t & reader,
+  const int64_t sn,
+  const DDS_Duration_t * const max_wait,
+  bool & matched)
+{
+  DDS_InstanceHandle_t reader_ih;
+  rmw_connextdds_gid_to_ih(reader, reader_ih);
+  matched = true;
+
+  const bool wait_forever =
+    DDS_Duration_is_infinite(max_wait) == DDS_BOOLEAN_TRUE;
+  rcutils_time_point_value_t deadline = 0;
+  if (!wait_forever) {
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&deadline)) {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to get current time")
+      return RMW_RET_ERROR;
+    }
+    deadline += RCUTILS_S_TO_NS(static_cast<int64_t>(max_wait->sec)) +
+      static_cast<int64_t>(max_wait->nanosec);
+  }
+
+  while (true) {
+    DDS_DataWriterProtocolStatus status =
+      DDS_DataWriterProtocolStatus_INITIALIZER;
+    if (DDS_RETCODE_OK !=
+      DDS_DataWriter_get_matched_subscription_datawriter_protocol_status(
+        pub->writer(), &status, &reader_ih))
+    {
+      // Nothing to wait for if the reader is no longer matched
+      matched = false;
+      return RMW_RET_OK;
+    }
+
+    // Acknowledgments are cumulative, so the sample has been acknowledged
+    // once the reader's first unacknowledged sample follows it (or there
+    // are no unacknowledged samples).
+    int64_t first_unacked = 0;
+    rmw_connextdds_sn_dds_to_ros(
+      status.first_unacknowledged_sample_virtual_sequence_number,
+      first_unacked);
+    if (first_unacked <= 0 || first_unacked > sn) {
+      return RMW_RET_OK;
+    }
+
+    if (!wait_forever) {
+      rcutils_time_point_value_t now = 0;
+      if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+        RMW_CONNEXT_LOG_ERROR_SET("failed to get current time")
+        return RMW_RET_ERROR;
+      }
+      if (now >= deadline) {
+        RMW_SET_ERROR_MSG("timed out while waiting for acknowledgments");
+        return RMW_RET_TIMEOUT;
+      }
+    }
+
+    std::this_thread::sleep_for(
+      std::chrono::milliseconds(RMW_CONNEXT_REPLY_STREAM_POLL_PERIOD_MS));
+  }
+}
+
 rmw_ret_t
 rmw_connextdds_take_samples(
-  RMW_Connext_Subscriber * const sub)
+  RMW_Connext_Subscriber * const sub,
+  RMW_Connext_UntypedSampleSeq * const data_seq,
+  DDS_SampleInfoSeq * const info_seq)
 {
   DDS_Boolean is_loan = DDS_BOOLEAN_TRUE;
   DDS_Long data_len = 0;
@@ -600,7 +1163,7 @@ rmw_connextdds_take_samples(
     &is_loan,
     &data_buffer,
     &data_len,
-    sub->info_seq(),
+    info_seq,
     0 /* data_seq_len */,
     0 /* data_seq_max_len */,
     DDS_BOOLEAN_TRUE /* data_seq_has_ownership */,
@@ -623,7 +1186,7 @@ rmw_connextdds_take_samples(
     return RMW_RET_ERROR;
   }
   RMW_CONNEXT_ASSERT(data_len > 0)(void) RMW_Connext_Uint8ArrayPtrSeq_loan_contiguous(
-    sub->data_seq(),
+    data_seq,
     reinterpret_cast<rcutils_uint8_array_t **>(data_buffer),
     data_len,
     data_len);
@@ -633,14 +1196,16 @@ rmw_connextdds_take_samples(
 
 rmw_ret_t
 rmw_connextdds_return_samples(
-  RMW_Connext_Subscriber * const sub)
+  RMW_Connext_Subscriber * const sub,
+  RMW_Connext_UntypedSampleSeq * const data_seq,
+  DDS_SampleInfoSeq * const info_seq)
 {
   void ** data_buffer = reinterpret_cast<void **>(
-    RMW_Connext_Uint8ArrayPtrSeq_get_contiguous_buffer(sub->data_seq()));
+    RMW_Connext_Uint8ArrayPtrSeq_get_contiguous_buffer(data_seq));
   const DDS_Long data_len =
-    RMW_Connext_Uint8ArrayPtrSeq_get_length(sub->data_seq());
+    RMW_Connext_Uint8ArrayPtrSeq_get_length(data_seq);
 
-  if (!RMW_Connext_Uint8ArrayPtrSeq_unloan(sub->data_seq())) {
+  if (!RMW_Connext_Uint8ArrayPtrSeq_unloan(data_seq)) {
     RMW_CONNEXT_LOG_ERROR_SET("failed to unloan sample sequence")
     return RMW_RET_ERROR;
   }
@@ -649,7 +1214,7 @@ rmw_connextdds_return_samples(
       sub->reader(),
       data_buffer,
       data_len,
-      sub->info_seq()))
+      info_seq))
   {
     RMW_CONNEXT_LOG_ERROR_SET("failed to return loan to DDS reader")
     return RMW_RET_ERROR;
@@ -699,6 +1264,12 @@ rmw_connextdds_filter_sample(
         &writer_guid, &related_sample_identity.writer_guid) == 0);
   }
 
+  if (*accepted && sub->condition()->filter_request_target) {
+    *accepted = rmw_connextdds_request_target_matches(
+      reinterpret_cast<const rcutils_uint8_array_t *>(sample),
+      &sub->condition()->request_target_gid);
+  }
+
   return RMW_RET_OK;
 }
 
@@ -854,7 +1425,7 @@ rmw_connextdds_parse_map(uint8_t * const data, const DDS_Long data_len)
 
 static rmw_ret_t
 rmw_connextdds_get_user_data_key(
-  const DDS_ParticipantBuiltinTopicData * const data,
+  const DDS_UserDataQosPolicy * const data,
   const std::string key,
   std::string & value,
   bool & found)
@@ -862,9 +1433,9 @@ rmw_connextdds_get_user_data_key(
   found = false;
   uint8_t * const user_data =
     reinterpret_cast<uint8_t *>(
-    DDS_OctetSeq_get_contiguous_buffer(&data->user_data.value));
+    DDS_OctetSeq_get_contiguous_buffer(&data->value));
   const DDS_Long user_data_len =
-    DDS_OctetSeq_get_length(&data->user_data.value);
+    DDS_OctetSeq_get_length(&data->value);
   if (nullptr == user_data || user_data_len == 0) {
     return RMW_RET_OK;
   }
@@ -877,6 +1448,256 @@ rmw_connextdds_get_user_data_key(
   return RMW_RET_OK;
 }
 
+rmw_ret_t
+rmw_connextdds_set_paired_endpoint(
+  RMW_Connext_Publisher * const pub,
+  const rmw_gid_t & paired)
+{
+  DDS_DataWriterQos qos = DDS_DataWriterQos_INITIALIZER;
+  auto scope_exit_qos = rcpputils::make_scope_exit(
+    [&qos]()
+    {
+      DDS_DataWriterQos_finalize(&qos);
+    });
+
+  if (DDS_RETCODE_OK != DDS_DataWriter_get_qos(pub->writer(), &qos)) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get writer's qos")
+    return RMW_RET_ERROR;
+  }
+
+  char entry[64];
+  int entry_len = std::snprintf(entry, sizeof(entry), "paired=");
+  for (size_t i = 0; i < MIG_RTPS_KEY_HASH_MAX_LENGTH; i++) {
+    entry_len += std::snprintf(
+      entry + entry_len, sizeof(entry) - entry_len, "%02x", paired.data[i]);
+  }
+  entry_len += std::snprintf(
+    entry + entry_len, sizeof(entry) - entry_len, ";");
+
+  rmw_ret_t rc =
+    rmw_connextdds_append_user_data(&qos.user_data, entry, entry_len);
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
+  // user_data is mutable, but set it before the writer is enabled, so that
+  // it is already part of the writer's first announcement.
+  if (DDS_RETCODE_OK != DDS_DataWriter_set_qos(pub->writer(), &qos)) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to set writer's qos")
+    return RMW_RET_ERROR;
+  }
+
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_get_paired_endpoint(
+  RMW_Connext_Subscriber * const sub,
+  const rmw_gid_t & writer,
+  rmw_gid_t & paired,
+  bool & found)
+{
+  found = false;
+
+  DDS_InstanceHandle_t writer_ih;
+  rmw_connextdds_gid_to_ih(writer, writer_ih);
+
+  DDS_PublicationBuiltinTopicData data =
+    DDS_PublicationBuiltinTopicData_INITIALIZER;
+  auto scope_exit_data = rcpputils::make_scope_exit(
+    [&data]()
+    {
+      DDS_PublicationBuiltinTopicData_finalize(&data);
+    });
+
+  if (DDS_RETCODE_OK !=
+    DDS_DataReader_get_matched_publication_data(
+      sub->reader(), &data, &writer_ih))
+  {
+    // The writer is not (or no longer) matched
+    return RMW_RET_OK;
+  }
+
+  std::string paired_str;
+  bool paired_found = false;
+  rmw_ret_t rc = rmw_connextdds_get_user_data_key(
+    &data.user_data, "paired", paired_str, paired_found);
+  if (RMW_RET_OK != rc || !paired_found) {
+    return rc;
+  }
+  if (paired_str.length() != MIG_RTPS_KEY_HASH_MAX_LENGTH * 2) {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "ignoring invalid paired endpoint: '%s'", paired_str.c_str())
+    return RMW_RET_OK;
+  }
+
+  memset(&paired, 0, sizeof(paired));
+  paired.implementation_identifier = RMW_CONNEXTDDS_ID;
+  for (size_t i = 0; i < MIG_RTPS_KEY_HASH_MAX_LENGTH; i++) {
+    paired.data[i] = static_cast<uint8_t>(
+      strtoul(paired_str.substr(i * 2, 2).c_str(), nullptr, 16));
+  }
+  found = true;
+  return RMW_RET_OK;
+}
+
+#if RMW_CONNEXT_TYPE_HASH
+static
+uint64_t
+rmw_connextdds_get_type_hash_user_data(
+  const DDS_UserDataQosPolicy * const user_data)
+{
+  std::string hash_str;
+  bool hash_found = false;
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_user_data_key(
+      user_data, "typehash", hash_str, hash_found) || !hash_found)
+  {
+    return 0;
+  }
+  return strtoull(hash_str.c_str(), nullptr, 16);
+}
+
+static
+void
+rmw_connextdds_ignore_endpoint(
+  rmw_context_impl_t * const ctx,
+  const DDS_InstanceHandle_t * const ih,
+  const bool is_reader,
+  const char * const type_name)
+{
+  const DDS_ReturnCode_t rc = is_reader ?
+    DDS_DomainParticipant_ignore_subscription(ctx->participant, ih) :
+    DDS_DomainParticipant_ignore_publication(ctx->participant, ih);
+  if (DDS_RETCODE_OK != rc) {
+    RMW_CONNEXT_LOG_ERROR_A(
+      "failed to ignore remote %s with incompatible type: %s",
+      is_reader ? "reader" : "writer", type_name)
+    return;
+  }
+  RMW_CONNEXT_LOG_WARNING_A(
+    "ignored remote %s with incompatible type: %s",
+    is_reader ? "reader" : "writer", type_name)
+  ctx->incompatible_type_detected();
+}
+
+// Record the type hash advertised by a remote endpoint, and ignore the
+// endpoint if it doesn't match the hash of the local type with the same
+// name. Returns false if the endpoint was ignored.
+static
+bool
+rmw_connextdds_check_remote_type_hash(
+  rmw_context_impl_t * const ctx,
+  const DDS_InstanceHandle_t * const ih,
+  const bool is_reader,
+  const char * const type_name,
+  const DDS_UserDataQosPolicy * const user_data)
+{
+  const uint64_t hash = rmw_connextdds_get_type_hash_user_data(user_data);
+  if (0 == hash) {
+    // Endpoints which don't advertise a hash are always accepted.
+    return true;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(ctx->type_hash_mutex);
+    auto local = ctx->local_type_hashes.find(type_name);
+    if (local == ctx->local_type_hashes.end() || local->second == hash) {
+      try {
+        ctx->remote_type_hashes[type_name].push_back({*ih, is_reader, hash});
+      } catch (const std::exception &) {
+        // The endpoint will not be checked against types registered later.
+      }
+      return true;
+    }
+  }
+
+  rmw_connextdds_ignore_endpoint(ctx, ih, is_reader, type_name);
+  return false;
+}
+
+static
+void
+rmw_connextdds_forget_remote_type_hash(
+  rmw_context_impl_t * const ctx,
+  const DDS_InstanceHandle_t * const ih)
+{
+  std::lock_guard<std::mutex> guard(ctx->type_hash_mutex);
+  for (auto it = ctx->remote_type_hashes.begin();
+    it != ctx->remote_type_hashes.end(); ++it)
+  {
+    auto & endpoints = it->second;
+    for (auto e = endpoints.begin(); e != endpoints.end(); ++e) {
+      if (DDS_InstanceHandle_equals(&e->handle, ih)) {
+        endpoints.erase(e);
+        if (endpoints.empty()) {
+          ctx->remote_type_hashes.erase(it);
+        }
+        return;
+      }
+    }
+  }
+}
+#endif /* RMW_CONNEXT_TYPE_HASH */
+
+rmw_ret_t
+rmw_connextdds_assert_type_hash(
+  rmw_context_impl_t * const ctx,
+  RMW_Connext_MessageTypeSupport * const type_support)
+{
+#if RMW_CONNEXT_TYPE_HASH
+  const uint64_t hash = type_support->type_hash();
+  if (0 == hash) {
+    return RMW_RET_OK;
+  }
+
+  std::vector<RMW_Connext_RemoteTypeHash> incompatible;
+  {
+    std::lock_guard<std::mutex> guard(ctx->type_hash_mutex);
+    try {
+      auto local = ctx->local_type_hashes.emplace(
+        type_support->type_name(), hash);
+      if (!local.second && local.first->second != hash) {
+        RMW_CONNEXT_LOG_WARNING_A(
+          "local types with the same name but different structure: %s",
+          type_support->type_name())
+        return RMW_RET_OK;
+      }
+
+      // Remote endpoints discovered before the type was registered
+      auto remote = ctx->remote_type_hashes.find(type_support->type_name());
+      if (remote != ctx->remote_type_hashes.end()) {
+        auto & endpoints = remote->second;
+        for (auto e = endpoints.begin(); e != endpoints.end(); ) {
+          if (e->hash != hash) {
+            incompatible.push_back(*e);
+            e = endpoints.erase(e);
+          } else {
+            ++e;
+          }
+        }
+        if (endpoints.empty()) {
+          ctx->remote_type_hashes.erase(remote);
+        }
+      }
+    } catch (const std::exception &) {
+      RMW_CONNEXT_LOG_ERROR_SET("failed to record type hash")
+      return RMW_RET_ERROR;
+    }
+  }
+
+  for (auto & e : incompatible) {
+    rmw_connextdds_ignore_endpoint(
+      ctx, &e.handle, e.is_reader, type_support->type_name());
+    rmw_connextdds_graph_remove_entity(ctx, &e.handle, e.is_reader);
+  }
+#else
+  UNUSED_ARG(ctx);
+  UNUSED_ARG(type_support);
+#endif /* RMW_CONNEXT_TYPE_HASH */
+  return RMW_RET_OK;
+}
+
 rmw_ret_t
 rmw_connextdds_dcps_participant_on_data(rmw_context_impl_t * const ctx)
 {
@@ -933,7 +1754,7 @@ rmw_connextdds_dcps_participant_on_data(rmw_context_impl_t * const ctx)
       bool enclave_found;
 
       rmw_ret_t rc = rmw_connextdds_get_user_data_key(
-        data, "enclave", enclave_str, enclave_found);
+        &data->user_data, "enclave", enclave_str, enclave_found);
       if (RMW_RET_OK != rc) {
         RMW_CONNEXT_LOG_ERROR("failed to parse user data for enclave")
         continue;
@@ -999,6 +1820,9 @@ rmw_connextdds_dcps_publication_on_data(rmw_context_impl_t * const ctx)
         if (info->instance_state == DDS_NOT_ALIVE_DISPOSED_INSTANCE_STATE ||
           info->instance_state == DDS_NOT_ALIVE_NO_WRITERS_INSTANCE_STATE)
         {
+#if RMW_CONNEXT_TYPE_HASH
+          rmw_connextdds_forget_remote_type_hash(ctx, &info->instance_handle);
+#endif /* RMW_CONNEXT_TYPE_HASH */
           if (RMW_RET_OK !=
             rmw_connextdds_graph_remove_entity(
               ctx, &info->instance_handle, false /* is_reader */))
@@ -1012,6 +1836,15 @@ rmw_connextdds_dcps_publication_on_data(rmw_context_impl_t * const ctx)
         continue;
       }
 
+#if RMW_CONNEXT_TYPE_HASH
+      if (!rmw_connextdds_check_remote_type_hash(
+          ctx, &info->instance_handle, false /* is_reader */,
+          data->type_name, &data->user_data))
+      {
+        continue;
+      }
+#endif /* RMW_CONNEXT_TYPE_HASH */
+
       DDS_GUID_t endp_guid;
       DDS_GUID_t dp_guid;
 
@@ -1084,6 +1917,9 @@ rmw_connextdds_dcps_subscription_on_data(rmw_context_impl_t * const ctx)
         if (info->instance_state == DDS_NOT_ALIVE_DISPOSED_INSTANCE_STATE ||
           info->instance_state == DDS_NOT_ALIVE_NO_WRITERS_INSTANCE_STATE)
         {
+#if RMW_CONNEXT_TYPE_HASH
+          rmw_connextdds_forget_remote_type_hash(ctx, &info->instance_handle);
+#endif /* RMW_CONNEXT_TYPE_HASH */
           if (RMW_RET_OK !=
             rmw_connextdds_graph_remove_entity(
               ctx, &info->instance_handle, true /* is_reader */))
@@ -1097,6 +1933,15 @@ rmw_connextdds_dcps_subscription_on_data(rmw_context_impl_t * const ctx)
         continue;
       }
 
+#if RMW_CONNEXT_TYPE_HASH
+      if (!rmw_connextdds_check_remote_type_hash(
+          ctx, &info->instance_handle, true /* is_reader */,
+          data->type_name, &data->user_data))
+      {
+        continue;
+      }
+#endif /* RMW_CONNEXT_TYPE_HASH */
+
       DDS_GUID_t endp_guid;
       DDS_GUID_t dp_guid;
 
@@ -754,14 +754,13 @@ rmw_connextdds_register_type_support(
   const bool intro_members_cpp,
   const char * const type_name)
 {
-  UNUSED_ARG(ctx);
-
   registered = false;
 
   RMW_Connext_MessageTypeSupport * type_support = nullptr;
   try {
     type_support = new RMW_Connext_MessageTypeSupport(
-      message_type, type_supports, type_name);
+      message_type, type_supports, type_name,
+      ctx, intro_members, intro_members_cpp);
   } catch (const std::exception & e) {
     RMW_CONNEXT_LOG_ERROR_A_SET("failed to create type support: %s", e.what())
   }
@@ -920,7 +919,8 @@ rmw_ret_t
 rmw_connextdds_unregister_type_support(
   rmw_context_impl_t * const ctx,
   DDS_DomainParticipant * const participant,
-  const char * const type_name)
+  const char * const type_name,
+  const bool keep_registered)
 {
   UNUSED_ARG(ctx);
 
@@ -935,7 +935,7 @@ rmw_connextdds_unregister_type_support(
 
   tc->type_plugin->attached_count -= 1;
 
-  if (tc->type_plugin->attached_count == 0) {
+  if (tc->type_plugin->attached_count == 0 && !keep_registered) {
     /* Cache type_name into a string, since may be deallocated
        by DDS_DomainParticipant_unregister_type() */
     std::string tname(type_name);
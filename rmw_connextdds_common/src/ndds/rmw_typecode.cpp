@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "rmw_connextdds/typecode.hpp"
@@ -479,8 +481,110 @@ rmw_connextdds_convert_type_members(
 }
 
 
+/******************************************************************************
+ * Precomputed TypeCodes
+ ******************************************************************************/
+struct RMW_Connext_TypeCodeEntry
+{
+  RMW_Connext_TypeCodeProvider provider;
+  // Hash of the type's structure when the TypeCode was generated.
+  uint64_t type_hash;
+};
+
+// Providers may be registered by other libraries' static initializers, so
+// the registry is only created on first use.
+static std::mutex &
+rmw_connextdds_typecode_registry_mutex()
+{
+  static std::mutex registry_mutex;
+  return registry_mutex;
+}
+
+static std::map<std::string, RMW_Connext_TypeCodeEntry> &
+rmw_connextdds_typecode_registry()
+{
+  static std::map<std::string, RMW_Connext_TypeCodeEntry> registry;
+  return registry;
+}
+
+rmw_ret_t
+rmw_connextdds_register_typecode(
+  const char * const type_name,
+  RMW_Connext_TypeCodeProvider provider,
+  const uint64_t type_hash)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(provider, RMW_RET_INVALID_ARGUMENT);
+
+  std::lock_guard<std::mutex> guard(rmw_connextdds_typecode_registry_mutex());
+  try {
+    rmw_connextdds_typecode_registry()[type_name] =
+      RMW_Connext_TypeCodeEntry{provider, type_hash};
+  } catch (const std::exception &) {
+    RMW_CONNEXT_LOG_ERROR_A_SET(
+      "failed to register precomputed type code: %s", type_name)
+    return RMW_RET_BAD_ALLOC;
+  }
+  return RMW_RET_OK;
+}
+
 DDS_TypeCode *
-rmw_connextdds_create_typecode(
+rmw_connextdds_lookup_typecode(
+  const char * const type_name,
+  uint64_t * const type_hash)
+{
+  RMW_Connext_TypeCodeProvider provider = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(rmw_connextdds_typecode_registry_mutex());
+    auto & registry = rmw_connextdds_typecode_registry();
+    if (registry.empty()) {
+      return nullptr;
+    }
+    auto found = registry.find(type_name);
+    if (found == registry.end()) {
+      return nullptr;
+    }
+    provider = found->second.provider;
+    if (nullptr != type_hash) {
+      *type_hash = found->second.type_hash;
+    }
+  }
+
+  const DDS_TypeCode * const tc = provider();
+  if (nullptr == tc) {
+    return nullptr;
+  }
+
+  DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+  const char * const tc_name = DDS_TypeCode_name(tc, &ex);
+  if (nullptr == tc_name || DDS_NO_EXCEPTION_CODE != ex ||
+    strcmp(tc_name, type_name) != 0)
+  {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "ignored precomputed type code with unexpected name: %s", type_name)
+    return nullptr;
+  }
+
+  DDS_TypeCodeFactory * const tc_factory = DDS_TypeCodeFactory_get_instance();
+  if (nullptr == tc_factory) {
+    RMW_CONNEXT_LOG_ERROR_SET("failed to get DDS_TypeCodeFactory")
+    return nullptr;
+  }
+
+  // Return a copy, so that it can be released like a generated type code.
+  DDS_TypeCode * const tc_copy =
+    DDS_TypeCodeFactory_clone_tc(tc_factory, tc, &ex);
+  if (nullptr == tc_copy || DDS_NO_EXCEPTION_CODE != ex) {
+    RMW_CONNEXT_LOG_ERROR_A(
+      "failed to copy precomputed type code: %s", type_name)
+    return nullptr;
+  }
+
+  return tc_copy;
+}
+
+static DDS_TypeCode *
+rmw_connextdds_generate_typecode(
   const rosidl_message_type_support_t * const type_supports,
   const char * const type_name,
   const void * const intro_members_in,
@@ -599,6 +703,81 @@ rmw_connextdds_create_typecode(
   return tc;
 }
 
+DDS_TypeCode *
+rmw_connextdds_create_typecode(
+  const rosidl_message_type_support_t * const type_supports,
+  const char * const type_name,
+  const void * const intro_members_in,
+  const bool intro_members_cpp,
+  RMW_Connext_TypeCodePtrSeq * const tc_cache)
+{
+  if (nullptr != type_name) {
+    uint64_t precomputed_hash = 0;
+    DDS_TypeCode * const precomputed_tc =
+      rmw_connextdds_lookup_typecode(type_name, &precomputed_hash);
+    if (nullptr != precomputed_tc) {
+      // The precomputed type code was checked against the type's definition
+      // when it was built, so only check that the type hasn't changed since.
+      const uint64_t type_hash =
+        RMW_Connext_MessageTypeSupport::compute_type_hash(
+        type_supports, intro_members_in, intro_members_cpp);
+      if (type_hash == precomputed_hash) {
+        RMW_CONNEXT_LOG_DEBUG_A(
+          "using precomputed type code: %s", type_name)
+        return precomputed_tc;
+      }
+      RMW_CONNEXT_LOG_ERROR_A(
+        "precomputed type code was built for a different version of "
+        "the type, ignoring it: %s", type_name)
+      rmw_connextdds_delete_typecode(precomputed_tc);
+    }
+  }
+
+  return rmw_connextdds_generate_typecode(
+    type_supports, type_name, intro_members_in, intro_members_cpp, tc_cache);
+}
+
+rmw_ret_t
+rmw_connextdds_check_typecode(
+  const rosidl_message_type_support_t * const type_supports,
+  const char * const type_name,
+  const DDS_TypeCode * const precomputed_tc,
+  uint64_t * const type_hash)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_supports, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(precomputed_tc, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_hash, RMW_RET_INVALID_ARGUMENT);
+
+  *type_hash = RMW_Connext_MessageTypeSupport::compute_type_hash(type_supports);
+
+#if RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+  DDS_TypeCode * const tc =
+    rmw_connextdds_generate_typecode(
+    type_supports, type_name, nullptr, false, nullptr);
+  if (nullptr == tc) {
+    return RMW_RET_ERROR;
+  }
+  auto scope_exit_tc_delete = rcpputils::make_scope_exit(
+    [tc]()
+    {
+      rmw_connextdds_delete_typecode(tc);
+    });
+
+  DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+  if (DDS_BOOLEAN_TRUE != DDS_TypeCode_equal(precomputed_tc, tc, &ex) ||
+    DDS_NO_EXCEPTION_CODE != ex)
+  {
+    RMW_CONNEXT_LOG_ERROR_A_SET(
+      "precomputed type code differs from the type's definition: %s",
+      type_name)
+    return RMW_RET_ERROR;
+  }
+#endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
+
+  return RMW_RET_OK;
+}
+
 void
 rmw_connextdds_delete_typecode(DDS_TypeCode * const tc)
 {
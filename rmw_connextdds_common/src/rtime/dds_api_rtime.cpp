@@ -18,9 +18,10 @@
 
 #include "rmw_connextdds/type_support.hpp"
 #include "rmw_connextdds/rmw_impl.hpp"
+#include "rmw_connextdds/config.hpp"
 #include "rmw_connextdds/graph_cache.hpp"
 
-#include "rcutils/get_env.h"
+#include "rcutils/time.h"
 
 struct RMW_Connext_BuiltinListener;
 
@@ -540,16 +541,9 @@ rmw_connextdds_initialize_participant_factory(
 
   /* Lookup name of UDP interface from environment */
   const char * env_udp_intf = nullptr;
-  const char * lookup_rc =
-    rcutils_get_env(RMW_CONNEXT_ENV_UDP_INTERFACE, &env_udp_intf);
-
-  if (nullptr != lookup_rc || nullptr == env_udp_intf) {
-    RMW_CONNEXT_LOG_ERROR_A_SET(
-      "failed to lookup from environment: "
-      "var=%s, "
-      "rc=%s ",
-      RMW_CONNEXT_ENV_UDP_INTERFACE,
-      lookup_rc)
+  if (RMW_RET_OK !=
+    rmw_connextdds_get_env(RMW_CONNEXT_ENV_UDP_INTERFACE, &env_udp_intf))
+  {
     return RMW_RET_ERROR;
   }
 
@@ -740,8 +734,6 @@ rmw_connextdds_initialize_participant_qos_impl(
   rmw_context_impl_t * const ctx,
   DDS_DomainParticipantQos * const dp_qos)
 {
-  UNUSED_ARG(ctx);
-
   /* TODO(asorbini:) Store enclave's name in USER_DATA field */
 
   /*  TODO(asorbini) Configure DDS Security options */
@@ -842,19 +834,41 @@ rmw_connextdds_initialize_participant_qos_impl(
   dp_qos->resource_limits.remote_reader_allocation =
     RMW_CONNEXT_LIMIT_READERS_REMOTE_MAX;
 
-  dp_qos->resource_limits.local_publisher_allocation = 1;
+  /* One publisher/subscriber for the context, plus one for each node
+     if they were requested */
+  const size_t pubsub_max =
+    1 + (ctx->pubsub_per_node ? RMW_CONNEXT_LIMIT_NODES_LOCAL_MAX : 0);
+
+  dp_qos->resource_limits.local_publisher_allocation = pubsub_max;
 
-  dp_qos->resource_limits.local_subscriber_allocation = 1;
+  dp_qos->resource_limits.local_subscriber_allocation = pubsub_max;
 
+  /* remote_writer_allocation and remote_reader_allocation already account
+     for the endpoints of all remote participants, so every local endpoint
+     can match at most all of them. */
   dp_qos->resource_limits.matching_reader_writer_pair_allocation =
     dp_qos->resource_limits.local_reader_allocation *
-    dp_qos->resource_limits.remote_writer_allocation *
-    dp_qos->resource_limits.remote_participant_allocation;
+    dp_qos->resource_limits.remote_writer_allocation;
 
   dp_qos->resource_limits.matching_writer_reader_pair_allocation =
     dp_qos->resource_limits.local_writer_allocation *
-    dp_qos->resource_limits.remote_reader_allocation *
-    dp_qos->resource_limits.remote_participant_allocation;
+    dp_qos->resource_limits.remote_reader_allocation;
+
+  if (RMW_CONNEXT_LIMIT_MATCHES_MAX > 0) {
+    dp_qos->resource_limits.matching_reader_writer_pair_allocation =
+      std::min<DDS_Long>(
+      dp_qos->resource_limits.matching_reader_writer_pair_allocation,
+      RMW_CONNEXT_LIMIT_MATCHES_MAX);
+    dp_qos->resource_limits.matching_writer_reader_pair_allocation =
+      std::min<DDS_Long>(
+      dp_qos->resource_limits.matching_writer_reader_pair_allocation,
+      RMW_CONNEXT_LIMIT_MATCHES_MAX);
+  }
+
+  RMW_CONNEXT_LOG_DEBUG_A(
+    "participant matching pairs: reader_writer=%d, writer_reader=%d",
+    dp_qos->resource_limits.matching_reader_writer_pair_allocation,
+    dp_qos->resource_limits.matching_writer_reader_pair_allocation)
 
   if (!RT_ComponentFactoryId_set_name(
       &dp_qos->discovery.discovery.name, "dpde"))
@@ -899,6 +913,7 @@ rmw_connextdds_delete_contentfilteredtopic(
 static
 rmw_ret_t
 rmw_connextdds_get_qos_policies(
+  const RMW_Connext_QosOverride * const qos_override,
   const bool writer_qos,
   RMW_Connext_MessageTypeSupport * const type_support,
   DDS_HistoryQosPolicy * const history,
@@ -919,7 +934,6 @@ rmw_connextdds_get_qos_policies(
 #endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
 )
 {
-  UNUSED_ARG(type_support);
   UNUSED_ARG(writer_qos);
   UNUSED_ARG(reliability);
   UNUSED_ARG(durability);
@@ -943,6 +957,28 @@ rmw_connextdds_get_qos_policies(
     max_samples = RMW_CONNEXT_LIMIT_SAMPLES_MAX;
   }
 
+  const size_t depth_samples =
+    (DDS_LENGTH_UNLIMITED != history->depth && history->depth > 0) ?
+    static_cast<size_t>(history->depth) : 1;
+
+  /* Each sample is preallocated with the type's max serialized size, so
+     limit the number of samples of large types to the pool's budget */
+  if (RMW_CONNEXT_LIMIT_SAMPLES_POOL_SIZE_MAX > 0 && !type_support->unbounded()) {
+    const size_t pool_samples = std::max<size_t>(
+      1,
+      RMW_CONNEXT_LIMIT_SAMPLES_POOL_SIZE_MAX /
+      type_support->type_serialized_size_max());
+    if (pool_samples < max_samples) {
+      max_samples = std::max(pool_samples, depth_samples);
+    }
+  }
+
+  /* A QoS override's max_samples takes precedence over the pool's budget */
+  if (nullptr != qos_override && qos_override->max_samples > 0) {
+    max_samples = std::max(
+      static_cast<size_t>(qos_override->max_samples), depth_samples);
+  }
+
   resource_limits->max_samples_per_instance = max_samples;
   resource_limits->max_samples = max_samples;
   resource_limits->max_instances = 1;   /* ROS doesn't use instances */
@@ -964,7 +1000,8 @@ rmw_connextdds_get_qos_policies(
       RMW_CONNEXT_LIMIT_WRITERS_LOCAL_MAX +
       RMW_CONNEXT_LIMIT_WRITERS_REMOTE_MAX;
     // reader_resource_limits->max_samples_per_remote_writer = 0;
-    reader_resource_limits->max_outstanding_reads = 1;
+    reader_resource_limits->max_outstanding_reads =
+      RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX;
     reader_resource_limits->max_routes_per_writer = 1;
   }
 
@@ -975,15 +1012,34 @@ rmw_connextdds_get_qos_policies(
     writer_resource_limits->max_routes_per_reader = 1;
   }
 
+  /* Micro only supports a subset of the reliability protocol's settings:
+     fast heartbeats and NACK/heartbeat response delays are ignored. */
+  RMW_Connext_ReliabilityProtocol preset;
+  const bool has_preset = nullptr != qos_override &&
+    rmw_connextdds_get_reliability_preset(
+    qos_override->reliability_preset, &preset);
+
   if (nullptr != reader_protocol) {
-    reader_protocol->rtps_reliable_reader.nack_period.sec = 0;
-    reader_protocol->rtps_reliable_reader.nack_period.nanosec = 10000000;
+    rmw_connextdds_duration_from_ms(
+      has_preset ? preset.nack_period_ms : 10,
+      &reader_protocol->rtps_reliable_reader.nack_period);
   }
 
   if (nullptr != writer_protocol) {
     RMW_CONNEXT_ASSERT(nullptr != writer_resource_limits)
-    writer_protocol->rtps_reliable_writer.heartbeats_per_max_samples =
-      resource_limits->max_samples;
+    DDS_RtpsReliableWriterProtocol_t * const rtps_writer =
+      &writer_protocol->rtps_reliable_writer;
+    rtps_writer->heartbeats_per_max_samples = resource_limits->max_samples;
+    if (has_preset) {
+      rmw_connextdds_duration_from_ms(
+        preset.heartbeat_period_ms, &rtps_writer->heartbeat_period);
+      rtps_writer->heartbeats_per_max_samples = std::min<DDS_Long>(
+        preset.heartbeats_per_max_samples, resource_limits->max_samples);
+      if (preset.send_window_max > 0) {
+        rtps_writer->max_send_window = std::min<DDS_Long>(
+          preset.send_window_max, resource_limits->max_samples);
+      }
+    }
   }
   return RMW_RET_OK;
 }
@@ -1001,8 +1057,44 @@ rmw_connextdds_get_datawriter_qos(
 #endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
 )
 {
-  UNUSED_ARG(ctx);
-  UNUSED_ARG(topic);
+  const char * const topic_name =
+    DDS_TopicDescription_get_name(DDS_Topic_as_topicdescription(topic));
+  const RMW_Connext_QosOverride * const qos_override =
+    rmw_connextdds_find_qos_override(
+    ctx, topic_name, type_support->type_name());
+
+  if (nullptr != qos_override && qos_override->batch_max_samples > 0) {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "batching not supported, ignored for topic: %s", topic_name)
+  }
+
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  const rmw_connextdds_publisher_options_t * const opts =
+    (nullptr != pub_options) ?
+    static_cast<const rmw_connextdds_publisher_options_t *>(
+    pub_options->rmw_specific_publisher_payload) : nullptr;
+  if (nullptr != opts && 0 != opts->flow_rate) {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "flow controllers not supported, ignored for topic: %s", topic_name)
+  }
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  if (nullptr != qos_override && qos_override->flow_rate > 0) {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "flow controllers not supported, ignored for topic: %s", topic_name)
+  }
+
+  if (0 !=
+    rmw_connextdds_get_writer_transport_priority(
+      qos_override
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+      ,
+      pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  ))
+  {
+    RMW_CONNEXT_LOG_WARNING_A(
+      "transport priority not supported, ignored for topic: %s", topic_name)
+  }
 
   if (RMW_RET_OK !=
     rmw_connextdds_get_readerwriter_qos(
@@ -1018,6 +1110,7 @@ rmw_connextdds_get_datawriter_qos(
 #if RMW_CONNEXT_HAVE_LIFESPAN_QOS
       nullptr /* Micro doesn't support DDS_LifespanQosPolicy */,
 #endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS */
+      qos_override,
       qos_policies
 #if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
       ,
@@ -1029,7 +1122,20 @@ rmw_connextdds_get_datawriter_qos(
     return RMW_RET_ERROR;
   }
 
+  rmw_ret_t rc = rmw_connextdds_get_writer_blocking_qos(
+    ctx,
+    &qos->reliability
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+    ,
+    pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  );
+  if (RMW_RET_OK != rc) {
+    return rc;
+  }
+
   return rmw_connextdds_get_qos_policies(
+    qos_override,
     true /* writer_qos */,
     type_support,
     &qos->history,
@@ -1063,8 +1169,10 @@ rmw_connextdds_get_datareader_qos(
 #endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
 )
 {
-  UNUSED_ARG(ctx);
-  UNUSED_ARG(topic_desc);
+  const char * const topic_name = DDS_TopicDescription_get_name(topic_desc);
+  const RMW_Connext_QosOverride * const qos_override =
+    rmw_connextdds_find_qos_override(
+    ctx, topic_name, type_support->type_name());
 
   if (RMW_RET_OK !=
     rmw_connextdds_get_readerwriter_qos(
@@ -1080,6 +1188,7 @@ rmw_connextdds_get_datareader_qos(
 #if RMW_CONNEXT_HAVE_LIFESPAN_QOS
       nullptr /* Lifespan is a writer-only qos policy */,
 #endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS */
+      qos_override,
       qos_policies
 #if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
       ,
@@ -1091,6 +1200,7 @@ rmw_connextdds_get_datareader_qos(
     return RMW_RET_ERROR;
   }
   return rmw_connextdds_get_qos_policies(
+    qos_override,
     false /* writer_qos */,
     type_support,
     &qos->history,
@@ -1191,9 +1301,12 @@ rmw_connextdds_write_message(
 {
   UNUSED_ARG(sn_out);
 
-  if (DDS_RETCODE_OK !=
-    DDS_DataWriter_write(pub->writer(), message, &DDS_HANDLE_NIL))
-  {
+  const DDS_ReturnCode_t rc =
+    DDS_DataWriter_write(pub->writer(), message, &DDS_HANDLE_NIL);
+  if (DDS_RETCODE_TIMEOUT == rc) {
+    RMW_SET_ERROR_MSG("timed out while writing message to DDS");
+    return RMW_RET_TIMEOUT;
+  } else if (DDS_RETCODE_OK != rc) {
     RMW_CONNEXT_LOG_ERROR_SET("failed to write message to DDS")
     return RMW_RET_ERROR;
   }
@@ -1201,15 +1314,75 @@ rmw_connextdds_write_message(
   return RMW_RET_OK;
 }
 
+rmw_ret_t
+rmw_connextdds_set_flow_rate(
+  RMW_Connext_Publisher * const pub,
+  const uint64_t rate,
+  const uint64_t burst)
+{
+  UNUSED_ARG(pub);
+  UNUSED_ARG(rate);
+  UNUSED_ARG(burst);
+  RMW_CONNEXT_LOG_ERROR_SET("flow controllers not supported")
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_connextdds_wait_for_reply_acknowledgment(
+  RMW_Connext_Publisher * const pub,
+  const rmw_gid_t & reader,
+  const int64_t sn,
+  const DDS_Duration_t * const max_wait,
+  bool & matched)
+{
+  // Micro doesn't report the acknowledgment state of each reader: rely on
+  // reliable writers blocking (up to max_blocking_time) once their send
+  // window or resource limits are exhausted.
+  UNUSED_ARG(pub);
+  UNUSED_ARG(reader);
+  UNUSED_ARG(sn);
+  UNUSED_ARG(max_wait);
+  matched = true;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_set_paired_endpoint(
+  RMW_Connext_Publisher * const pub,
+  const rmw_gid_t & paired)
+{
+  // Micro doesn't propagate user data in discovery: remote applications
+  // fall back to pairing endpoints by their GUID prefix.
+  UNUSED_ARG(pub);
+  UNUSED_ARG(paired);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_connextdds_get_paired_endpoint(
+  RMW_Connext_Subscriber * const sub,
+  const rmw_gid_t & writer,
+  rmw_gid_t & paired,
+  bool & found)
+{
+  UNUSED_ARG(sub);
+  UNUSED_ARG(writer);
+  UNUSED_ARG(paired);
+  found = false;
+  return RMW_RET_OK;
+}
+
 rmw_ret_t
 rmw_connextdds_take_samples(
-  RMW_Connext_Subscriber * const sub)
+  RMW_Connext_Subscriber * const sub,
+  RMW_Connext_UntypedSampleSeq * const data_seq,
+  DDS_SampleInfoSeq * const info_seq)
 {
   DDS_ReturnCode_t rc =
     DDS_DataReader_take(
     sub->reader(),
-    sub->data_seq(),
-    sub->info_seq(),
+    data_seq,
+    info_seq,
     DDS_LENGTH_UNLIMITED,
     DDS_ANY_VIEW_STATE,
     DDS_ANY_SAMPLE_STATE,
@@ -1227,11 +1400,12 @@ rmw_connextdds_take_samples(
 
 rmw_ret_t
 rmw_connextdds_return_samples(
-  RMW_Connext_Subscriber * const sub)
+  RMW_Connext_Subscriber * const sub,
+  RMW_Connext_UntypedSampleSeq * const data_seq,
+  DDS_SampleInfoSeq * const info_seq)
 {
   if (DDS_RETCODE_OK !=
-    DDS_DataReader_return_loan(
-      sub->reader(), sub->data_seq(), sub->info_seq()))
+    DDS_DataReader_return_loan(sub->reader(), data_seq, info_seq))
   {
     RMW_CONNEXT_LOG_ERROR_SET("failed to return data to DDS reader")
     return RMW_RET_ERROR;
@@ -1239,6 +1413,64 @@ rmw_connextdds_return_samples(
   return RMW_RET_OK;
 }
 
+/* Check whether the request header included at the beginning of a
+   sample's payload (see RMW_CONNEXT_EMULATE_REQUESTREPLY) refers to a
+   request sent by the specified writer. */
+static
+bool
+rmw_connextdds_related_writer_matches(
+  const rcutils_uint8_array_t * const data_buffer,
+  const DDS_GUID_t * const writer_guid)
+{
+  const size_t header_offset =
+    RMW_Connext_MessageTypeSupport::ENCAPSULATION_HEADER_SIZE;
+  if (data_buffer->buffer_length < header_offset + RMW_GID_STORAGE_SIZE) {
+    return false;
+  }
+
+  rmw_gid_t related_gid;
+  related_gid.implementation_identifier = RMW_CONNEXTDDS_ID;
+  memcpy(
+    related_gid.data,
+    data_buffer->buffer + header_offset,
+    RMW_GID_STORAGE_SIZE);
+
+  DDS_GUID_t related_writer_guid = DDS_GUID_INITIALIZER;
+  rmw_connextdds_gid_to_guid(related_gid, related_writer_guid);
+
+  return DDS_GUID_compare(writer_guid, &related_writer_guid) == 0;
+}
+
+/* Emulate DDS_LifespanQosPolicy on the reader side, by detecting samples
+   whose source timestamp is older than the subscription's lifespan. */
+static
+bool
+rmw_connextdds_sample_expired(
+  RMW_Connext_SubscriberStatusCondition * const cond,
+  const struct DDS_SampleInfo * const sample_info)
+{
+  if (0 == cond->lifespan_ns) {
+    return false;
+  }
+
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+    RMW_CONNEXT_LOG_ERROR("failed to get current time")
+    return false;
+  }
+
+  const int64_t source_ts =
+    static_cast<int64_t>(sample_info->source_timestamp.sec) * 1000000000LL +
+    static_cast<int64_t>(sample_info->source_timestamp.nanosec);
+
+  if (now - source_ts <= cond->lifespan_ns) {
+    return false;
+  }
+
+  cond->expire_sample();
+  return true;
+}
+
 rmw_ret_t
 rmw_connextdds_filter_sample(
   RMW_Connext_Subscriber * const sub,
@@ -1247,26 +1479,28 @@ rmw_connextdds_filter_sample(
   const DDS_InstanceHandle_t * const request_writer_handle,
   bool * const accepted)
 {
-  UNUSED_ARG(sub);
-  UNUSED_ARG(sample);
-  UNUSED_ARG(info);
-  // In this implementation, local samples are dropped by the
+  // In this implementation, local samples (and replies filtered by
+  // the subscriber's condition) are dropped by the
   // DataReaderListener::on_before_sample_commit() callback.
   *accepted = true;
 
+  // Samples might have expired while waiting in the reader's cache.
+  if (rmw_connextdds_sample_expired(sub->condition(), info)) {
+    *accepted = false;
+    return RMW_RET_OK;
+  }
+
   if (nullptr != request_writer_handle) {
-    const RMW_Connext_RequestReplyMessage * const rr_msg =
-      reinterpret_cast<const RMW_Connext_RequestReplyMessage *>(sample);
     // Convert instance handle to guid
-    DDS_GUID_t writer_guid = DDS_GUID_INITIALIZER,
-      related_writer_guid = DDS_GUID_INITIALIZER;
+    DDS_GUID_t writer_guid = DDS_GUID_INITIALIZER;
     memcpy(
       writer_guid.value,
       request_writer_handle->octet,
       16);
-    rmw_connextdds_gid_to_guid(rr_msg->gid, related_writer_guid);
     *accepted =
-      (DDS_GUID_compare(&writer_guid, &related_writer_guid) == 0);
+      rmw_connextdds_related_writer_matches(
+      reinterpret_cast<const rcutils_uint8_array_t *>(sample),
+      &writer_guid);
   }
 
   return RMW_RET_OK;
@@ -1711,6 +1945,18 @@ rmw_connextdds_enable_builtin_readers(rmw_context_impl_t * const ctx)
   return RMW_RET_OK;
 }
 
+rmw_ret_t
+rmw_connextdds_assert_type_hash(
+  rmw_context_impl_t * const ctx,
+  RMW_Connext_MessageTypeSupport * const type_support)
+{
+  // Micro doesn't propagate the user data of endpoints, so type hashes
+  // can't be advertised, and remote endpoints are never ignored.
+  UNUSED_ARG(ctx);
+  UNUSED_ARG(type_support);
+  return RMW_RET_OK;
+}
+
 rmw_ret_t
 rmw_connextdds_dcps_participant_on_data(rmw_context_impl_t * const ctx)
 {
@@ -1877,7 +2123,7 @@ rmw_connextdds_ih_to_gid(
 
 static
 DDS_Boolean
-RMW_Connext_DataReaderListener_before_sample_commit_drop_local(
+RMW_Connext_DataReaderListener_before_sample_commit(
   void * listener_data,
   DDS_DataReader * reader,
   const void * const sample,
@@ -1885,16 +2131,34 @@ RMW_Connext_DataReaderListener_before_sample_commit_drop_local(
   DDS_Boolean * dropped)
 {
   UNUSED_ARG(reader);
-  UNUSED_ARG(sample);
 
   RMW_Connext_SubscriberStatusCondition * const self =
     reinterpret_cast<RMW_Connext_SubscriberStatusCondition *>(listener_data);
 
-  *dropped = memcmp(
-    self->participant_handle.octet,
-    sample_info->publication_handle.octet,
-    12) == 0 ?
-    DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE;
+  *dropped = DDS_BOOLEAN_FALSE;
+
+  if (self->ignore_local &&
+    memcmp(
+      self->participant_handle.octet,
+      sample_info->publication_handle.octet,
+      12) == 0)
+  {
+    *dropped = DDS_BOOLEAN_TRUE;
+  } else if (self->filter_related_writer &&
+    !rmw_connextdds_related_writer_matches(
+      reinterpret_cast<const rcutils_uint8_array_t *>(sample),
+      &self->related_writer_guid))
+  {
+    *dropped = DDS_BOOLEAN_TRUE;
+  } else if (self->filter_request_target &&
+    !rmw_connextdds_request_target_matches(
+      reinterpret_cast<const rcutils_uint8_array_t *>(sample),
+      &self->request_target_gid))
+  {
+    *dropped = DDS_BOOLEAN_TRUE;
+  } else if (rmw_connextdds_sample_expired(self, sample_info)) {
+    *dropped = DDS_BOOLEAN_TRUE;
+  }
 
   return DDS_BOOLEAN_TRUE;
 }
@@ -1905,11 +2169,12 @@ rmw_connextdds_configure_subscriber_condition_listener(
   DDS_DataReaderListener * const listener,
   DDS_StatusMask * const listener_mask)
 {
-  UNUSED_ARG(cond);
   UNUSED_ARG(listener_mask);
-  if (cond->ignore_local) {
+  if (cond->ignore_local || 0 != cond->lifespan_ns ||
+    cond->filter_related_writer || cond->filter_request_target)
+  {
     listener->on_before_sample_commit =
-      RMW_Connext_DataReaderListener_before_sample_commit_drop_local;
+      RMW_Connext_DataReaderListener_before_sample_commit;
   }
 }
 
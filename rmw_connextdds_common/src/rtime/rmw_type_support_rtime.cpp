@@ -852,16 +852,13 @@ rmw_connextdds_register_type_support(
   const bool intro_members_cpp,
   const char * const type_name)
 {
-  UNUSED_ARG(ctx);
-  UNUSED_ARG(intro_members);
-  UNUSED_ARG(intro_members_cpp);
-
   registered = false;
 
   RMW_Connext_MessageTypeSupport * type_support = nullptr;
   try {
     type_support = new RMW_Connext_MessageTypeSupport(
-      message_type, type_supports, type_name);
+      message_type, type_supports, type_name,
+      ctx, intro_members, intro_members_cpp);
   } catch (const std::exception & e) {
     RMW_CONNEXT_LOG_ERROR_A_SET("failed to create type support: %s", e.what())
   }
@@ -918,10 +915,18 @@ rmw_ret_t
 rmw_connextdds_unregister_type_support(
   rmw_context_impl_t * const ctx,
   DDS_DomainParticipant * const participant,
-  const char * const type_name)
+  const char * const type_name,
+  const bool keep_registered)
 {
   UNUSED_ARG(ctx);
 
+  // The type plugin is owned by the RMW, and it cannot be released before
+  // the endpoints that use it (see RMW_CONNEXT_FAST_TEARDOWN).
+  if (keep_registered) {
+    RMW_CONNEXT_LOG_ERROR_SET("type must be unregistered explicitly")
+    return RMW_RET_ERROR;
+  }
+
   DDS_TypePluginI * reg_intf = nullptr;
 
   if (RMW_RET_OK !=
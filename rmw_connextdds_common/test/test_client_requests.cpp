@@ -0,0 +1,513 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "rmw_connextdds/resource_limits.hpp"
+
+#include "test_msgs/srv/basic_types.h"
+
+#include "test_utils.hpp"
+
+static const size_t pending_requests_max = RMW_CONNEXT_LIMIT_PENDING_REQUESTS_MAX;
+
+class TestClientRequests : public ::testing::Test
+{
+protected:
+  explicit TestClientRequests(const char * const server_selection = "all")
+  : server_selection(RMW_CONNEXT_ENV_SERVER_SELECTION, server_selection)
+  {}
+
+  void
+  SetUp() override
+  {
+    this->node = this->test_ctx.create_node("test_client_requests");
+    ASSERT_NE(nullptr, this->node) << rmw_get_error_string().str;
+    this->client =
+      rmw_api_connextdds_create_client(
+      this->node,
+      ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes),
+      "/test_client_requests",
+      &rmw_qos_profile_services_default);
+    ASSERT_NE(nullptr, this->client) << rmw_get_error_string().str;
+    ASSERT_TRUE(test_msgs__srv__BasicTypes_Request__init(&this->request));
+  }
+
+  void
+  TearDown() override
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&this->request);
+    if (nullptr != this->client) {
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_destroy_client(this->node, this->client));
+    }
+    if (nullptr != this->node) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node));
+    }
+  }
+
+  rmw_ret_t
+  send_request(int64_t & sn)
+  {
+    return rmw_api_connextdds_send_request(this->client, &this->request, &sn);
+  }
+
+  size_t
+  pending_requests()
+  {
+    size_t count = 0;
+    EXPECT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_client_get_pending_requests_count(
+        this->client, &count));
+    return count;
+  }
+
+  rmw_connextdds_request_timeout_status_t
+  timeout_status()
+  {
+    rmw_connextdds_request_timeout_status_t status{0, 0, 0};
+    EXPECT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_client_get_request_timeout_status(
+        this->client, &status));
+    return status;
+  }
+
+  ScopedEnv server_selection;
+  TestContext test_ctx;
+  rmw_node_t * node{nullptr};
+  rmw_client_t * client{nullptr};
+  test_msgs__srv__BasicTypes_Request request;
+};
+
+/* Requests which aren't replied before their timeout are no longer tracked,
+   and they are reported in the client's timeout status. */
+TEST_F(TestClientRequests, pending_request_times_out)
+{
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_api_connextdds_client_set_request_timeout(this->client, 50));
+
+  int64_t sn = 0;
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(1u, this->pending_requests());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  EXPECT_EQ(0u, this->pending_requests());
+  rmw_connextdds_request_timeout_status_t status = this->timeout_status();
+  EXPECT_EQ(1u, status.total_count);
+  EXPECT_EQ(1u, status.total_count_change);
+  EXPECT_EQ(sn, status.last_sequence_number);
+
+  status = this->timeout_status();
+  EXPECT_EQ(1u, status.total_count);
+  EXPECT_EQ(0u, status.total_count_change);
+}
+
+/* Without a timeout, sending a request never fails because of the pending
+   ones: the oldest pending request is considered timed out instead. */
+TEST_F(TestClientRequests, pending_requests_limit_without_timeout)
+{
+  int64_t first_sn = 0;
+  int64_t sn = 0;
+  for (size_t i = 0; i < pending_requests_max; i++) {
+    ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) <<
+      rmw_get_error_string().str;
+    if (0 == i) {
+      first_sn = sn;
+    }
+  }
+  EXPECT_EQ(pending_requests_max, this->pending_requests());
+  EXPECT_EQ(0u, this->timeout_status().total_count);
+
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(pending_requests_max, this->pending_requests());
+  rmw_connextdds_request_timeout_status_t status = this->timeout_status();
+  EXPECT_EQ(1u, status.total_count);
+  EXPECT_EQ(first_sn, status.last_sequence_number);
+
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(pending_requests_max, this->pending_requests());
+  status = this->timeout_status();
+  EXPECT_EQ(2u, status.total_count);
+  EXPECT_EQ(first_sn + 1, status.last_sequence_number);
+}
+
+/* With a timeout, the oldest pending request is considered timed out to make
+   room for a new one. */
+TEST_F(TestClientRequests, pending_requests_limit_with_timeout)
+{
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_api_connextdds_client_set_request_timeout(this->client, 60000));
+
+  int64_t first_sn = 0;
+  int64_t sn = 0;
+  for (size_t i = 0; i < pending_requests_max; i++) {
+    ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) <<
+      rmw_get_error_string().str;
+    if (0 == i) {
+      first_sn = sn;
+    }
+  }
+
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(pending_requests_max, this->pending_requests());
+  const rmw_connextdds_request_timeout_status_t status = this->timeout_status();
+  EXPECT_EQ(1u, status.total_count);
+  EXPECT_EQ(first_sn, status.last_sequence_number);
+}
+
+class TestServerSelection : public TestClientRequests
+{
+protected:
+  explicit TestServerSelection(
+    const char * const server_selection = "least-outstanding")
+  : TestClientRequests(server_selection)
+  {}
+
+  rmw_service_t *
+  create_service()
+  {
+    return rmw_api_connextdds_create_service(
+      this->node,
+      ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes),
+      "/test_client_requests",
+      &rmw_qos_profile_services_default);
+  }
+
+  bool
+  wait_for_servers(const size_t count)
+  {
+    for (int i = 0; i < 1000; i++) {
+      size_t servers_count = 0;
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_client_get_available_servers(
+          this->client, nullptr, 0, &servers_count));
+      if (servers_count == count) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  }
+};
+
+/* Requests sent to a server which is no longer available are dropped, since
+   they will never be replied, and they no longer count towards its load. */
+TEST_F(TestServerSelection, drops_requests_of_departed_servers)
+{
+  rmw_service_t * const service = this->create_service();
+  ASSERT_NE(nullptr, service) << rmw_get_error_string().str;
+  ASSERT_TRUE(this->wait_for_servers(1));
+
+  int64_t sn = 0;
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(1u, this->pending_requests());
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service));
+  ASSERT_TRUE(this->wait_for_servers(0));
+
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(1u, this->pending_requests());
+  EXPECT_EQ(0u, this->timeout_status().total_count);
+}
+
+// Connext Micro can't tell apart the servers of a single participant
+#if RMW_CONNEXT_HAVE_REQUEST_TARGET && \
+  RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO
+/* A server which replaces a departed one starts with no outstanding
+   requests, so it is selected before the servers which have some. */
+TEST_F(TestServerSelection, least_outstanding_forgets_departed_servers)
+{
+  rmw_service_t * const service_a = this->create_service();
+  ASSERT_NE(nullptr, service_a) << rmw_get_error_string().str;
+  rmw_service_t * const service_b = this->create_service();
+  ASSERT_NE(nullptr, service_b) << rmw_get_error_string().str;
+  ASSERT_TRUE(this->wait_for_servers(2));
+
+  // One request is sent to each server
+  int64_t sn = 0;
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(2u, this->pending_requests());
+
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service_a));
+  ASSERT_TRUE(this->wait_for_servers(1));
+  rmw_service_t * const service_c = this->create_service();
+  ASSERT_NE(nullptr, service_c) << rmw_get_error_string().str;
+  ASSERT_TRUE(this->wait_for_servers(2));
+
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+  EXPECT_EQ(2u, this->pending_requests());
+
+  // The new request is only delivered to service_c
+  test_msgs__srv__BasicTypes_Request taken_request;
+  ASSERT_TRUE(test_msgs__srv__BasicTypes_Request__init(&taken_request));
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  rmw_service_info_t request_header;
+#else
+  rmw_request_id_t request_header;
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+  bool taken = false;
+  for (int i = 0; i < 500 && !taken; i++) {
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_take_request(
+        service_c, &request_header, &taken_request, &taken));
+    if (!taken) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  EXPECT_TRUE(taken);
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  EXPECT_EQ(sn, request_header.request_id.sequence_number);
+#else
+  EXPECT_EQ(sn, request_header.sequence_number);
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+  test_msgs__srv__BasicTypes_Request__fini(&taken_request);
+
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service_c));
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service_b));
+}
+
+class TestRoundRobinSelection : public TestServerSelection
+{
+protected:
+  TestRoundRobinSelection()
+  : TestServerSelection("round-robin")
+  {}
+
+  // Take all the requests delivered to a service within a short period.
+  std::vector<int64_t>
+  take_requests(rmw_service_t * const service)
+  {
+    std::vector<int64_t> sns;
+    test_msgs__srv__BasicTypes_Request taken_request;
+    EXPECT_TRUE(test_msgs__srv__BasicTypes_Request__init(&taken_request));
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+    rmw_service_info_t request_header;
+    const int64_t & sn = request_header.request_id.sequence_number;
+#else
+    rmw_request_id_t request_header;
+    const int64_t & sn = request_header.sequence_number;
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+    for (int i = 0; i < 50; i++) {
+      bool taken = false;
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_take_request(
+          service, &request_header, &taken_request, &taken));
+      if (taken) {
+        sns.push_back(sn);
+      } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    test_msgs__srv__BasicTypes_Request__fini(&taken_request);
+    return sns;
+  }
+};
+
+/* Services with the same name in the same participant are told apart, so
+   each request is only delivered to the server selected for it. */
+TEST_F(TestRoundRobinSelection, services_in_same_participant)
+{
+  rmw_service_t * const service_a = this->create_service();
+  ASSERT_NE(nullptr, service_a) << rmw_get_error_string().str;
+  rmw_service_t * const service_b = this->create_service();
+  ASSERT_NE(nullptr, service_b) << rmw_get_error_string().str;
+  ASSERT_TRUE(this->wait_for_servers(2));
+
+  std::vector<int64_t> sent;
+  for (int i = 0; i < 4; i++) {
+    int64_t sn = 0;
+    ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) <<
+      rmw_get_error_string().str;
+    sent.push_back(sn);
+  }
+
+  // Requests alternate between the two servers
+  const std::vector<int64_t> taken_a = this->take_requests(service_a);
+  const std::vector<int64_t> taken_b = this->take_requests(service_b);
+  ASSERT_EQ(2u, taken_a.size());
+  ASSERT_EQ(2u, taken_b.size());
+  const std::vector<int64_t> & first = (taken_a[0] == sent[0]) ? taken_a : taken_b;
+  const std::vector<int64_t> & second = (taken_a[0] == sent[0]) ? taken_b : taken_a;
+  EXPECT_EQ(sent[0], first[0]);
+  EXPECT_EQ(sent[2], first[1]);
+  EXPECT_EQ(sent[1], second[0]);
+  EXPECT_EQ(sent[3], second[1]);
+
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service_a));
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service_b));
+}
+#endif /* RMW_CONNEXT_HAVE_REQUEST_TARGET && \
+          RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO */
+
+#if RMW_CONNEXT_HAVE_REPLY_STREAM
+/* The parts of a streamed response are delivered in order, even if there
+   are more of them than the parts that may be unacknowledged at once. */
+TEST_F(TestServerSelection, streamed_response_parts_are_ordered)
+{
+  rmw_service_t * const service = this->create_service();
+  ASSERT_NE(nullptr, service) << rmw_get_error_string().str;
+  ASSERT_TRUE(this->wait_for_servers(1));
+
+  int64_t sn = 0;
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  rmw_service_info_t request_header;
+  rmw_service_info_t response_header;
+#else
+  rmw_request_id_t request_header;
+  rmw_request_id_t response_header;
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+  test_msgs__srv__BasicTypes_Request taken_request;
+  ASSERT_TRUE(test_msgs__srv__BasicTypes_Request__init(&taken_request));
+  bool taken = false;
+  for (int i = 0; i < 500 && !taken; i++) {
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_take_request(
+        service, &request_header, &taken_request, &taken));
+    if (!taken) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  test_msgs__srv__BasicTypes_Request__fini(&taken_request);
+  ASSERT_TRUE(taken);
+
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  rmw_request_id_t * const request_id = &request_header.request_id;
+#else
+  rmw_request_id_t * const request_id = &request_header;
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+
+  const int32_t parts_len = 4 * RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW;
+  test_msgs__srv__BasicTypes_Response response;
+  ASSERT_TRUE(test_msgs__srv__BasicTypes_Response__init(&response));
+
+  // Take the parts while they are sent, so that the service never waits for
+  // more than its window of parts.
+  std::thread sender(
+    [service, request_id, parts_len]() {
+      test_msgs__srv__BasicTypes_Response part;
+      ASSERT_TRUE(test_msgs__srv__BasicTypes_Response__init(&part));
+      for (int32_t i = 0; i < parts_len; i++) {
+        part.int32_value = i;
+        EXPECT_EQ(
+          RMW_RET_OK,
+          rmw_api_connextdds_send_response_part(
+            service, request_id, &part, i == parts_len - 1)) <<
+          rmw_get_error_string().str;
+      }
+      test_msgs__srv__BasicTypes_Response__fini(&part);
+    });
+
+  int32_t next_part = 0;
+  bool last = false;
+  for (int i = 0; i < 1000 && !last; i++) {
+    taken = false;
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_take_response_part(
+        this->client, &response_header, &response, &last, &taken));
+    if (!taken) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      continue;
+    }
+    EXPECT_EQ(next_part, response.int32_value);
+    EXPECT_EQ(next_part == parts_len - 1, last);
+    next_part += 1;
+  }
+  sender.join();
+
+  EXPECT_EQ(parts_len, next_part);
+  EXPECT_EQ(0u, this->pending_requests());
+  test_msgs__srv__BasicTypes_Response__fini(&response);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service));
+}
+
+/* A streamed response to a client which is gone doesn't wait for
+   acknowledgments, and its parts are still sent successfully. */
+TEST_F(TestServerSelection, streamed_response_to_departed_client)
+{
+  rmw_service_t * const service = this->create_service();
+  ASSERT_NE(nullptr, service) << rmw_get_error_string().str;
+  ASSERT_TRUE(this->wait_for_servers(1));
+
+  int64_t sn = 0;
+  ASSERT_EQ(RMW_RET_OK, this->send_request(sn)) << rmw_get_error_string().str;
+
+#if RMW_CONNEXT_HAVE_SERVICE_INFO
+  rmw_service_info_t request_header;
+  rmw_request_id_t * const request_id = &request_header.request_id;
+#else
+  rmw_request_id_t request_header;
+  rmw_request_id_t * const request_id = &request_header;
+#endif /* RMW_CONNEXT_HAVE_SERVICE_INFO */
+  test_msgs__srv__BasicTypes_Request taken_request;
+  ASSERT_TRUE(test_msgs__srv__BasicTypes_Request__init(&taken_request));
+  bool taken = false;
+  for (int i = 0; i < 500 && !taken; i++) {
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_take_request(
+        service, &request_header, &taken_request, &taken));
+    if (!taken) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  test_msgs__srv__BasicTypes_Request__fini(&taken_request);
+  ASSERT_TRUE(taken);
+
+  test_msgs__srv__BasicTypes_Response part;
+  ASSERT_TRUE(test_msgs__srv__BasicTypes_Response__init(&part));
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_api_connextdds_send_response_part(service, request_id, &part, false));
+
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_destroy_client(this->node, this->client));
+  this->client = nullptr;
+
+  const int32_t parts_len = 4 * RMW_CONNEXT_LIMIT_REPLY_STREAM_WINDOW;
+  for (int32_t i = 0; i < parts_len; i++) {
+    EXPECT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_send_response_part(
+        service, request_id, &part, i == parts_len - 1)) <<
+      rmw_get_error_string().str;
+  }
+  test_msgs__srv__BasicTypes_Response__fini(&part);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_service(this->node, service));
+}
+#endif /* RMW_CONNEXT_HAVE_REPLY_STREAM */
@@ -0,0 +1,199 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rmw_connextdds/config.hpp"
+
+#include "test_utils.hpp"
+
+static const char * const TEST_ENV = "RMW_CONNEXT_TEST_CONFIG";
+
+TEST(TestConfig, get_env)
+{
+  const char * value = nullptr;
+  EXPECT_EQ(RMW_RET_OK, rmw_connextdds_get_env(TEST_ENV, &value));
+  ASSERT_NE(nullptr, value);
+  EXPECT_STREQ("", value);
+
+  ScopedEnv env(TEST_ENV, "foo");
+  EXPECT_EQ(RMW_RET_OK, rmw_connextdds_get_env(TEST_ENV, &value));
+  EXPECT_STREQ("foo", value);
+}
+
+TEST(TestConfig, get_env_int64)
+{
+  int64_t value = -1;
+  EXPECT_EQ(RMW_RET_OK, rmw_connextdds_get_env_int64(TEST_ENV, 0, value));
+  EXPECT_EQ(-1, value);
+
+  {
+    ScopedEnv env(TEST_ENV, "1500");
+    EXPECT_EQ(RMW_RET_OK, rmw_connextdds_get_env_int64(TEST_ENV, 0, value));
+    EXPECT_EQ(1500, value);
+  }
+
+  const char * const invalid[] =
+  {"abc", "12abc", " ", "-1", "99999999999999999999"};
+  for (const char * const str : invalid) {
+    ScopedEnv env(TEST_ENV, str);
+    value = 7;
+    EXPECT_EQ(RMW_RET_ERROR, rmw_connextdds_get_env_int64(TEST_ENV, 0, value))
+      << "value: '" << str << "'";
+    EXPECT_EQ(7, value);
+    rmw_reset_error();
+  }
+}
+
+TEST(TestConfig, get_env_bool)
+{
+  bool value = true;
+  EXPECT_EQ(RMW_RET_OK, rmw_connextdds_get_env_bool(TEST_ENV, value));
+  EXPECT_TRUE(value);
+
+  {
+    ScopedEnv env(TEST_ENV, "0");
+    EXPECT_EQ(RMW_RET_OK, rmw_connextdds_get_env_bool(TEST_ENV, value));
+    EXPECT_FALSE(value);
+  }
+  {
+    ScopedEnv env(TEST_ENV, "1");
+    EXPECT_EQ(RMW_RET_OK, rmw_connextdds_get_env_bool(TEST_ENV, value));
+    EXPECT_TRUE(value);
+  }
+  {
+    ScopedEnv env(TEST_ENV, "true");
+    EXPECT_EQ(RMW_RET_ERROR, rmw_connextdds_get_env_bool(TEST_ENV, value));
+    rmw_reset_error();
+  }
+}
+
+TEST(TestConfig, get_env_choice)
+{
+  size_t choice = 5;
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_connextdds_get_env_choice(TEST_ENV, {"a", "b", "c"}, choice));
+  EXPECT_EQ(5u, choice);
+
+  {
+    ScopedEnv env(TEST_ENV, "c");
+    EXPECT_EQ(
+      RMW_RET_OK,
+      rmw_connextdds_get_env_choice(TEST_ENV, {"a", "b", "c"}, choice));
+    EXPECT_EQ(2u, choice);
+  }
+  {
+    ScopedEnv env(TEST_ENV, "d");
+    EXPECT_EQ(
+      RMW_RET_ERROR,
+      rmw_connextdds_get_env_choice(TEST_ENV, {"a", "b", "c"}, choice));
+    EXPECT_EQ(2u, choice);
+    EXPECT_NE(
+      nullptr,
+      strstr(rmw_get_error_string().str, "expected: 'a', 'b', 'c'"));
+    rmw_reset_error();
+  }
+}
+
+TEST(TestConfig, parse_config_table)
+{
+  std::istringstream table(
+    "  # comment only\n"
+    "rt/foo: depth=5 , max_samples = 10  # trailing comment\n"
+    "\n"
+    "*::Bar_:max_string=16\n"
+    "rt/empty:\n");
+  std::vector<RMW_Connext_ConfigEntry> entries;
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_connextdds_parse_config_table("test", table, '\n', entries));
+  ASSERT_EQ(3u, entries.size());
+
+  EXPECT_EQ("rt/foo", entries[0].pattern);
+  ASSERT_EQ(2u, entries[0].settings.size());
+  EXPECT_EQ("depth", entries[0].settings[0].first);
+  EXPECT_EQ("5", entries[0].settings[0].second);
+  EXPECT_EQ("max_samples", entries[0].settings[1].first);
+  EXPECT_EQ("10", entries[0].settings[1].second);
+  EXPECT_EQ("test", entries[0].source);
+  EXPECT_EQ("rt/foo: depth=5 , max_samples = 10", entries[0].text);
+
+  EXPECT_EQ("*::Bar_", entries[1].pattern);
+  ASSERT_EQ(1u, entries[1].settings.size());
+  EXPECT_EQ("max_string", entries[1].settings[0].first);
+  EXPECT_EQ("16", entries[1].settings[0].second);
+
+  EXPECT_EQ("rt/empty", entries[2].pattern);
+  EXPECT_TRUE(entries[2].settings.empty());
+}
+
+TEST(TestConfig, parse_config_table_rejects_malformed_entries)
+{
+  const char * const invalid[] = {
+    "no_separator",
+    ":depth=1",
+    "  : depth=1",
+    "rt/foo:depth",
+    "rt/foo:=1",
+    "rt/foo:depth=1,,max_samples=2",
+    "rt/foo:depth=1;rt/bar",
+  };
+  for (const char * const str : invalid) {
+    std::istringstream table(str);
+    std::vector<RMW_Connext_ConfigEntry> entries;
+    EXPECT_EQ(
+      RMW_RET_ERROR,
+      rmw_connextdds_parse_config_table("test", table, ';', entries)) <<
+      "table: '" << str << "'";
+    rmw_reset_error();
+  }
+}
+
+TEST(TestConfig, get_env_table)
+{
+  static const char * const TEST_ENV_FILE = "RMW_CONNEXT_TEST_CONFIG_FILE";
+  const std::string file_name =
+    ::testing::TempDir() + "test_config_table.txt";
+  {
+    std::ofstream file(file_name);
+    file << "rt/from_file:depth=2\n";
+  }
+
+  ScopedEnv env(TEST_ENV, "rt/a:depth=1; rt/b:depth=3");
+  ScopedEnv env_file(TEST_ENV_FILE, file_name.c_str());
+  std::vector<RMW_Connext_ConfigEntry> entries;
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_connextdds_get_env_table(TEST_ENV, TEST_ENV_FILE, entries));
+  ASSERT_EQ(3u, entries.size());
+  // Entries from the environment come first
+  EXPECT_EQ("rt/a", entries[0].pattern);
+  EXPECT_EQ("rt/b", entries[1].pattern);
+  EXPECT_EQ("rt/from_file", entries[2].pattern);
+  EXPECT_EQ(file_name, entries[2].source);
+
+  std::remove(file_name.c_str());
+  entries.clear();
+  EXPECT_EQ(
+    RMW_RET_ERROR,
+    rmw_connextdds_get_env_table(TEST_ENV, TEST_ENV_FILE, entries));
+  rmw_reset_error();
+}
@@ -0,0 +1,105 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "rmw_connextdds/rmw_impl.hpp"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+class TestContentFilter : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    this->node = this->test_ctx.create_node("test_content_filter");
+    ASSERT_NE(nullptr, this->node) << rmw_get_error_string().str;
+  }
+
+  void
+  TearDown() override
+  {
+    if (nullptr != this->node) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node));
+    }
+  }
+
+  RMW_Connext_Subscriber *
+  create_subscriber(const char * const cft_filter)
+  {
+    rmw_context_impl_t * const ctx = this->test_ctx.context.impl;
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+    rmw_subscription_options_t sub_options =
+      rmw_get_default_subscription_options();
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+    return RMW_Connext_Subscriber::create(
+      ctx,
+      ctx->participant,
+      ctx->dds_sub,
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes),
+      "test_content_filter",
+      &rmw_qos_profile_default,
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+      &sub_options,
+#else
+      false /* ignore_local_publications */,
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+      false /* internal */,
+      RMW_CONNEXT_MESSAGE_USERDATA,
+      nullptr /* intro_members */,
+      false /* intro_members_cpp */,
+      nullptr /* type_name */,
+      "test_content_filter_cft",
+      cft_filter);
+  }
+
+  void
+  delete_subscriber(RMW_Connext_Subscriber * const sub)
+  {
+    EXPECT_EQ(RMW_RET_OK, sub->finalize());
+    delete sub;
+  }
+
+  TestContext test_ctx;
+  rmw_node_t * node{nullptr};
+};
+
+/* A filter which can't be evaluated makes creating the subscriber fail,
+   rather than delivering the samples it would have rejected. Connext Micro
+   only evaluates the filters of the clients' reply readers. */
+TEST_F(TestContentFilter, unsupported_filter)
+{
+  RMW_Connext_Subscriber * const sub = this->create_subscriber("int32_value > 5");
+#if RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO
+  ASSERT_NE(nullptr, sub) << rmw_get_error_string().str;
+  this->delete_subscriber(sub);
+#else
+  EXPECT_EQ(nullptr, sub);
+  EXPECT_TRUE(rmw_error_is_set());
+  rmw_reset_error();
+#endif /* RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO */
+}
+
+TEST_F(TestContentFilter, related_writer_filter)
+{
+  RMW_Connext_Subscriber * const sub =
+    this->create_subscriber(
+    "@related_sample_identity.writer_guid.value = "
+    "&hex(0102030405060708090A0B0C0D0E0F10)");
+  ASSERT_NE(nullptr, sub) << rmw_get_error_string().str;
+  this->delete_subscriber(sub);
+}
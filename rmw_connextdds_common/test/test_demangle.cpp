@@ -0,0 +1,50 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "rmw_connextdds/demangle.hpp"
+#include "rmw_connextdds/resource_limits.hpp"
+
+TEST(TestDemangle, demangles_topics_and_types)
+{
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ("/chatter", _demangle_if_ros_topic("rt/chatter"));
+    EXPECT_EQ("/add_two_intsRequest", _demangle_if_ros_topic("rq/add_two_intsRequest"));
+    EXPECT_EQ("dds_topic", _demangle_if_ros_topic("dds_topic"));
+
+    EXPECT_EQ("std_msgs/msg/String", _demangle_if_ros_type("std_msgs::msg::dds_::String_"));
+    EXPECT_EQ("DdsType", _demangle_if_ros_type("DdsType"));
+  }
+}
+
+/* Topic and type names share the cache, but not their demangled forms. */
+TEST(TestDemangle, topics_and_types_are_cached_separately)
+{
+  const std::string name = "rt/foo::dds_::Bar_";
+  EXPECT_EQ("/foo::dds_::Bar_", _demangle_if_ros_topic(name));
+  EXPECT_EQ("rt/foo/Bar", _demangle_if_ros_type(name));
+  EXPECT_EQ("/foo::dds_::Bar_", _demangle_if_ros_topic(name));
+}
+
+TEST(TestDemangle, demangles_more_names_than_cached)
+{
+  for (size_t i = 0; i < 2 * RMW_CONNEXT_LIMIT_DEMANGLE_CACHE_MAX + 1; i++) {
+    const std::string topic = "/topic_" + std::to_string(i);
+    ASSERT_EQ(topic, _demangle_if_ros_topic("rt" + topic));
+  }
+  EXPECT_EQ("/topic_0", _demangle_if_ros_topic("rt/topic_0"));
+}
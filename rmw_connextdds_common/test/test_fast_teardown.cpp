@@ -0,0 +1,62 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+/* Endpoints destroyed after rmw_shutdown() are left to be deleted with the
+   DomainParticipant, and their type supports must stay alive until then. */
+TEST(TestFastTeardown, type_supports_outlive_participant)
+{
+  TestContext test_ctx;
+  rmw_context_impl_t * const impl = test_ctx.context.impl;
+
+  rmw_node_t * const node = test_ctx.create_node("test_fast_teardown");
+  ASSERT_NE(nullptr, node) << rmw_get_error_string().str;
+
+  const rosidl_message_type_support_t * const type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rmw_publisher_t * const pub =
+    test_create_publisher(node, type_support, "/test_fast_teardown");
+  ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+  rmw_subscription_t * const sub =
+    test_create_subscription(node, type_support, "/test_fast_teardown");
+  ASSERT_NE(nullptr, sub) << rmw_get_error_string().str;
+
+  test_ctx.shutdown();
+  EXPECT_EQ(RMW_CONNEXT_FAST_TEARDOWN, impl->fast_teardown());
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(node, pub)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_subscription(node, sub)) <<
+    rmw_get_error_string().str;
+
+#if RMW_CONNEXT_FAST_TEARDOWN
+  // The DDS endpoints still exist, and so do their type supports.
+  EXPECT_NE(nullptr, impl->participant);
+  EXPECT_EQ(2u, impl->retained_type_supports.size());
+#else
+  EXPECT_TRUE(impl->retained_type_supports.empty());
+#endif /* RMW_CONNEXT_FAST_TEARDOWN */
+
+  // Deleting the last node deletes the DomainParticipant, and then the
+  // retained type supports.
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(nullptr, impl->participant);
+  EXPECT_TRUE(impl->retained_type_supports.empty());
+}
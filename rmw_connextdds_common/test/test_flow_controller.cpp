@@ -0,0 +1,67 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+/* Publishers of a topic share its flow controller, so they must all request
+   the same rate and burst size. */
+TEST(TestFlowController, rejects_conflicting_rates)
+{
+  TestContext test_ctx;
+  rmw_node_t * const node = test_ctx.create_node("test_flow_controller");
+  ASSERT_NE(nullptr, node) << rmw_get_error_string().str;
+
+  const rosidl_message_type_support_t * const ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * const topic_name = "/test_flow_controller";
+
+  rmw_connextdds_publisher_options_t opts_a{};
+  opts_a.flow_rate = 100000;
+  rmw_publisher_t * const pub_a =
+    test_create_publisher(
+    node, ts, topic_name, &rmw_qos_profile_default, &opts_a);
+  ASSERT_NE(nullptr, pub_a) << rmw_get_error_string().str;
+
+  rmw_connextdds_publisher_options_t opts_b{};
+  opts_b.flow_rate = 2 * opts_a.flow_rate;
+  EXPECT_EQ(
+    nullptr,
+    test_create_publisher(
+      node, ts, topic_name, &rmw_qos_profile_default, &opts_b));
+  rmw_reset_error();
+
+  opts_b.flow_rate = opts_a.flow_rate;
+  opts_b.flow_burst = 4 * RMW_CONNEXT_FLOW_CONTROLLER_BURST_DEFAULT;
+  EXPECT_EQ(
+    nullptr,
+    test_create_publisher(
+      node, ts, topic_name, &rmw_qos_profile_default, &opts_b));
+  rmw_reset_error();
+
+  // A publisher requesting the same configuration shares the controller
+  rmw_publisher_t * const pub_b =
+    test_create_publisher(
+    node, ts, topic_name, &rmw_qos_profile_default, &opts_a);
+  ASSERT_NE(nullptr, pub_b) << rmw_get_error_string().str;
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(node, pub_b));
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(node, pub_a));
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node));
+}
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
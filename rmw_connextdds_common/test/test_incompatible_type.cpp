@@ -0,0 +1,64 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test_utils.hpp"
+
+static
+rmw_connextdds_incompatible_type_status_t
+incompatible_type_status(const rmw_node_t * const node)
+{
+  rmw_connextdds_incompatible_type_status_t status{0, 0};
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_api_connextdds_node_get_incompatible_type_status(node, &status));
+  return status;
+}
+
+/* Remote endpoints are ignored by the context's participant, but each node
+   reports the ones ignored since it last read the status. */
+TEST(TestIncompatibleType, change_count_is_tracked_per_node)
+{
+  TestContext test_ctx;
+  rmw_node_t * const node_a = test_ctx.create_node("test_incompatible_a");
+  ASSERT_NE(nullptr, node_a) << rmw_get_error_string().str;
+  rmw_node_t * const node_b = test_ctx.create_node("test_incompatible_b");
+  ASSERT_NE(nullptr, node_b) << rmw_get_error_string().str;
+
+  rmw_context_impl_t * const ctx = test_ctx.context.impl;
+  ctx->incompatible_type_detected();
+
+  rmw_connextdds_incompatible_type_status_t status =
+    incompatible_type_status(node_a);
+  EXPECT_EQ(1u, status.total_count);
+  EXPECT_EQ(1u, status.total_count_change);
+
+  status = incompatible_type_status(node_a);
+  EXPECT_EQ(1u, status.total_count);
+  EXPECT_EQ(0u, status.total_count_change);
+
+  // Reading the status from node_a didn't reset the changes for node_b
+  ctx->incompatible_type_detected();
+  status = incompatible_type_status(node_b);
+  EXPECT_EQ(2u, status.total_count);
+  EXPECT_EQ(2u, status.total_count_change);
+
+  status = incompatible_type_status(node_a);
+  EXPECT_EQ(2u, status.total_count);
+  EXPECT_EQ(1u, status.total_count_change);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node_b));
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node_a));
+}
@@ -0,0 +1,90 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "rmw/event.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+#if RMW_CONNEXT_HAVE_LIFESPAN_QOS && RMW_CONNEXT_HAVE_MESSAGE_LOST
+/* Samples older than the subscription's lifespan are never taken, and they
+   are reported as lost samples (emulated by the RMW with Connext Micro). */
+TEST(TestLifespan, expired_samples_are_reported_as_lost)
+{
+  TestContext test_ctx;
+
+  rmw_node_t * const node = test_ctx.create_node("test_lifespan");
+  ASSERT_NE(nullptr, node) << rmw_get_error_string().str;
+
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+  qos.lifespan.sec = 0;
+  qos.lifespan.nsec = 1000000;
+
+  const rosidl_message_type_support_t * const type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rmw_publisher_t * const pub =
+    test_create_publisher(node, type_support, "/test_lifespan", &qos);
+  ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+  rmw_subscription_t * const sub =
+    test_create_subscription(node, type_support, "/test_lifespan", &qos);
+  ASSERT_NE(nullptr, sub) << rmw_get_error_string().str;
+
+  rmw_event_t lost_event = rmw_get_zero_initialized_event();
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_api_connextdds_subscription_event_init(
+      &lost_event, sub, RMW_EVENT_MESSAGE_LOST)) << rmw_get_error_string().str;
+
+  test_msgs__msg__BasicTypes msg;
+  ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&msg));
+
+  // Publish until some samples have expired before being taken.
+  size_t lost = 0;
+  for (int i = 0; i < 50 && 0 == lost; i++) {
+    EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_publish(pub, &msg, nullptr)) <<
+      rmw_get_error_string().str;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    bool taken = false;
+    EXPECT_EQ(
+      RMW_RET_OK, rmw_api_connextdds_take(sub, &msg, &taken, nullptr));
+    EXPECT_FALSE(taken);
+
+    rmw_message_lost_status_t status;
+    taken = false;
+    EXPECT_EQ(
+      RMW_RET_OK, rmw_api_connextdds_take_event(&lost_event, &status, &taken));
+    EXPECT_TRUE(taken);
+    EXPECT_EQ(status.total_count, lost + status.total_count_change);
+    lost = status.total_count;
+  }
+  EXPECT_LT(0u, lost);
+
+  test_msgs__msg__BasicTypes__fini(&msg);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_subscription(node, sub)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(node, pub)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node)) <<
+    rmw_get_error_string().str;
+}
+#endif /* RMW_CONNEXT_HAVE_LIFESPAN_QOS && RMW_CONNEXT_HAVE_MESSAGE_LOST */
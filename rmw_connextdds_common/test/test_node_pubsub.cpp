@@ -0,0 +1,52 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+/* With RMW_CONNEXT_PUBSUB_SCOPE=node, a node may only be destroyed once the
+   endpoints created in its DDS publisher and subscriber have been destroyed. */
+TEST(TestNodePubSub, refuses_to_finalize_node_with_endpoints)
+{
+  ScopedEnv pubsub_scope(RMW_CONNEXT_ENV_PUBSUB_SCOPE, "node");
+  TestContext test_ctx;
+
+  rmw_node_t * const node = test_ctx.create_node("test_node_pubsub");
+  ASSERT_NE(nullptr, node) << rmw_get_error_string().str;
+
+  rmw_publisher_t * const pub =
+    test_create_publisher(
+    node,
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes),
+    "/test_node_pubsub");
+  ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+
+  EXPECT_EQ(RMW_RET_ERROR, rmw_api_connextdds_destroy_node(node));
+  rmw_reset_error();
+
+  // The publisher is still usable after the node refused to be finalized
+  test_msgs__msg__BasicTypes msg;
+  ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&msg));
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_publish(pub, &msg, nullptr)) <<
+    rmw_get_error_string().str;
+  test_msgs__msg__BasicTypes__fini(&msg);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(node, pub)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node)) <<
+    rmw_get_error_string().str;
+}
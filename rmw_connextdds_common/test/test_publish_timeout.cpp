@@ -0,0 +1,82 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+/* A KEEP_ALL publisher which may queue a single sample, and which never
+   blocks, fails to write as soon as the sample hasn't been acknowledged yet.
+   The failure is reported with RMW_RET_ERROR, and counted by the publisher. */
+TEST(TestPublishTimeout, write_timeouts_are_reported_as_errors)
+{
+  ScopedEnv blocking_time(RMW_CONNEXT_ENV_WRITE_BLOCKING_TIME, "0");
+  ScopedEnv qos_overrides(
+    RMW_CONNEXT_ENV_QOS_OVERRIDES, "rt/test_publish_timeout: max_samples=1");
+  TestContext test_ctx;
+
+  rmw_node_t * const node = test_ctx.create_node("test_publish_timeout");
+  ASSERT_NE(nullptr, node) << rmw_get_error_string().str;
+
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.history = RMW_QOS_POLICY_HISTORY_KEEP_ALL;
+  qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+
+  const rosidl_message_type_support_t * const type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * const topic_name = "/test_publish_timeout";
+  rmw_publisher_t * const pub =
+    test_create_publisher(node, type_support, topic_name, &qos);
+  ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+  rmw_subscription_t * const sub =
+    test_create_subscription(node, type_support, topic_name, &qos);
+  ASSERT_NE(nullptr, sub) << rmw_get_error_string().str;
+
+  test_msgs__msg__BasicTypes msg;
+  ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&msg));
+
+  uint64_t failed = 0;
+  for (int i = 0; i < 100; i++) {
+    const rmw_ret_t rc = rmw_api_connextdds_publish(pub, &msg, nullptr);
+    if (RMW_RET_OK != rc) {
+#if RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT
+      EXPECT_EQ(RMW_RET_TIMEOUT, rc);
+#else
+      EXPECT_EQ(RMW_RET_ERROR, rc);
+      EXPECT_NE(
+        std::string::npos,
+        std::string(rmw_get_error_string().str).find("write timed out"));
+#endif /* RMW_CONNEXT_HAVE_PUBLISH_TIMEOUT */
+      rmw_reset_error();
+      failed += 1;
+    }
+  }
+  test_msgs__msg__BasicTypes__fini(&msg);
+
+  uint64_t timeouts = 0;
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_publisher_get_write_timeouts(pub, &timeouts));
+  EXPECT_EQ(failed, timeouts);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_subscription(node, sub)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(node, pub)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node)) <<
+    rmw_get_error_string().str;
+}
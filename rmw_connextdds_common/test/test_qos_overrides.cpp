@@ -0,0 +1,269 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "rmw_connextdds/rmw_impl.hpp"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+class TestQosOverrides : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    this->node = this->test_ctx.create_node("test_qos_overrides");
+    ASSERT_NE(nullptr, this->node) << rmw_get_error_string().str;
+    this->qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    this->qos.depth = 1;
+  }
+
+  void
+  TearDown() override
+  {
+    if (nullptr != this->node) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node));
+    }
+  }
+
+  // Create a publisher and return the max_samples of its DataWriter.
+  DDS_Long
+  writer_max_samples(const char * const topic_name)
+  {
+    rmw_publisher_t * const pub =
+      test_create_publisher(
+      this->node,
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes),
+      topic_name,
+      &this->qos);
+    EXPECT_NE(nullptr, pub) << rmw_get_error_string().str;
+    if (nullptr == pub) {
+      return 0;
+    }
+
+    auto pub_impl = static_cast<RMW_Connext_Publisher *>(pub->data);
+    DDS_DataWriterQos dw_qos = DDS_DataWriterQos_INITIALIZER;
+    EXPECT_EQ(
+      DDS_RETCODE_OK, DDS_DataWriter_get_qos(pub_impl->writer(), &dw_qos));
+    const DDS_Long max_samples = dw_qos.resource_limits.max_samples;
+    DDS_DataWriterQos_finalize(&dw_qos);
+
+    EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(this->node, pub));
+    return max_samples;
+  }
+
+  ScopedEnv qos_overrides{
+    RMW_CONNEXT_ENV_QOS_OVERRIDES,
+    "rt/test_qos_topic: max_samples=5;"
+    "*::BasicTypes_: max_samples=3"};
+  TestContext test_ctx;
+  rmw_node_t * node{nullptr};
+  rmw_qos_profile_t qos{rmw_qos_profile_default};
+};
+
+/* Overrides apply to the endpoints whose topic or type name matches their
+   pattern, and the first matching entry is used. */
+TEST_F(TestQosOverrides, match_topic_or_type_name)
+{
+  EXPECT_EQ(5, this->writer_max_samples("/test_qos_topic"));
+  EXPECT_EQ(3, this->writer_max_samples("/test_qos_other_topic"));
+}
+
+/* The history depth is never reduced by max_samples. */
+TEST_F(TestQosOverrides, max_samples_preserves_depth)
+{
+  this->qos.depth = 8;
+  EXPECT_EQ(8, this->writer_max_samples("/test_qos_other_topic"));
+}
+
+#if RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO
+static
+int32_t
+duration_ms(const DDS_Duration_t & duration)
+{
+  return static_cast<int32_t>(duration.sec * 1000 + duration.nanosec / 1000000);
+}
+
+class TestReliabilityPresets : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    this->node = this->test_ctx.create_node("test_reliability_presets");
+    ASSERT_NE(nullptr, this->node) << rmw_get_error_string().str;
+    this->qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+  }
+
+  void
+  TearDown() override
+  {
+    if (nullptr != this->node) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node));
+    }
+  }
+
+  // Create a reliable publisher and subscription on a topic configured with
+  // a preset, and check their reliability protocol against its settings.
+  void
+  check_preset(
+    const char * const topic_name,
+    const RMW_Connext_ReliabilityProtocol & expected)
+  {
+    const rosidl_message_type_support_t * const ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+
+    rmw_publisher_t * const pub =
+      test_create_publisher(this->node, ts, topic_name, &this->qos);
+    ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+    auto pub_impl = static_cast<RMW_Connext_Publisher *>(pub->data);
+    DDS_DataWriterQos dw_qos = DDS_DataWriterQos_INITIALIZER;
+    EXPECT_EQ(
+      DDS_RETCODE_OK, DDS_DataWriter_get_qos(pub_impl->writer(), &dw_qos));
+    const DDS_RtpsReliableWriterProtocol_t & writer_protocol =
+      dw_qos.protocol.rtps_reliable_writer;
+    EXPECT_EQ(
+      expected.heartbeat_period_ms,
+      duration_ms(writer_protocol.heartbeat_period));
+    EXPECT_EQ(
+      expected.fast_heartbeat_period_ms,
+      duration_ms(writer_protocol.fast_heartbeat_period));
+    EXPECT_EQ(
+      expected.nack_response_delay_ms,
+      duration_ms(writer_protocol.max_nack_response_delay));
+    EXPECT_EQ(
+      expected.heartbeats_per_max_samples,
+      writer_protocol.heartbeats_per_max_samples);
+    if (expected.send_window_max > 0) {
+      EXPECT_EQ(expected.send_window_min, writer_protocol.min_send_window_size);
+      EXPECT_EQ(expected.send_window_max, writer_protocol.max_send_window_size);
+    } else {
+      EXPECT_EQ(DDS_LENGTH_UNLIMITED, writer_protocol.max_send_window_size);
+    }
+    DDS_DataWriterQos_finalize(&dw_qos);
+    EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(this->node, pub));
+
+    rmw_subscription_t * const sub =
+      test_create_subscription(this->node, ts, topic_name, &this->qos);
+    ASSERT_NE(nullptr, sub) << rmw_get_error_string().str;
+    auto sub_impl = static_cast<RMW_Connext_Subscriber *>(sub->data);
+    DDS_DataReaderQos dr_qos = DDS_DataReaderQos_INITIALIZER;
+    EXPECT_EQ(
+      DDS_RETCODE_OK, DDS_DataReader_get_qos(sub_impl->reader(), &dr_qos));
+    const DDS_RtpsReliableReaderProtocol_t & reader_protocol =
+      dr_qos.protocol.rtps_reliable_reader;
+    EXPECT_EQ(
+      expected.heartbeat_response_delay_ms,
+      duration_ms(reader_protocol.max_heartbeat_response_delay));
+    EXPECT_EQ(expected.nack_period_ms, duration_ms(reader_protocol.nack_period));
+    DDS_DataReaderQos_finalize(&dr_qos);
+    EXPECT_EQ(
+      RMW_RET_OK, rmw_api_connextdds_destroy_subscription(this->node, sub));
+  }
+
+  // Publish samples before a subscription is created, so that they may only
+  // reach it through the repairs of the preset's reliability protocol (i.e.
+  // heartbeats and NACKs), and check that it receives all of them in order.
+  void
+  check_repair(const char * const topic_name)
+  {
+    const int32_t samples_len = 100;
+    rmw_qos_profile_t qos = this->qos;
+    qos.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = samples_len;
+
+    const rosidl_message_type_support_t * const ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    rmw_publisher_t * const pub =
+      test_create_publisher(this->node, ts, topic_name, &qos);
+    ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+
+    test_msgs__msg__BasicTypes msg;
+    ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&msg));
+    for (int32_t i = 0; i < samples_len; i++) {
+      msg.int32_value = i;
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_publish(pub, &msg, nullptr)) <<
+        rmw_get_error_string().str;
+    }
+
+    rmw_subscription_t * const sub =
+      test_create_subscription(this->node, ts, topic_name, &qos);
+    EXPECT_NE(nullptr, sub) << rmw_get_error_string().str;
+    int32_t received = 0;
+    for (int i = 0; nullptr != sub && i < 1000 && received < samples_len; i++) {
+      bool taken = false;
+      EXPECT_EQ(
+        RMW_RET_OK, rmw_api_connextdds_take(sub, &msg, &taken, nullptr)) <<
+        rmw_get_error_string().str;
+      if (!taken) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        continue;
+      }
+      EXPECT_EQ(received, msg.int32_value);
+      received += 1;
+    }
+    EXPECT_EQ(samples_len, received);
+
+    test_msgs__msg__BasicTypes__fini(&msg);
+    if (nullptr != sub) {
+      EXPECT_EQ(
+        RMW_RET_OK, rmw_api_connextdds_destroy_subscription(this->node, sub));
+    }
+    EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_publisher(this->node, pub));
+  }
+
+  // max_samples is large enough for the send window of every preset not to
+  // be limited by the writer's queue.
+  ScopedEnv qos_overrides{
+    RMW_CONNEXT_ENV_QOS_OVERRIDES,
+    "rt/test_preset_low_latency: reliability=low-latency,max_samples=128;"
+    "rt/test_preset_bulk: reliability=bulk,max_samples=128;"
+    "rt/test_preset_lossy_link: reliability=lossy-link,max_samples=128"};
+  TestContext test_ctx;
+  rmw_node_t * node{nullptr};
+  rmw_qos_profile_t qos{rmw_qos_profile_default};
+};
+
+/* Expected settings, in the order of RMW_Connext_ReliabilityProtocol's
+   fields: {heartbeat_period, fast_heartbeat_period, nack_response_delay,
+   heartbeats_per_max_samples, send_window_min, send_window_max,
+   heartbeat_response_delay, nack_period} (durations in ms). */
+TEST_F(TestReliabilityPresets, low_latency)
+{
+  this->check_preset(
+    "/test_preset_low_latency", {100, 10, 0, 8, 0, 0, 0, 10});
+  this->check_repair("/test_preset_low_latency");
+}
+
+TEST_F(TestReliabilityPresets, bulk)
+{
+  this->check_preset(
+    "/test_preset_bulk", {200, 20, 5, 32, 8, 64, 5, 50});
+  this->check_repair("/test_preset_bulk");
+}
+
+TEST_F(TestReliabilityPresets, lossy_link)
+{
+  this->check_preset(
+    "/test_preset_lossy_link", {50, 5, 0, 64, 4, 32, 0, 5});
+  this->check_repair("/test_preset_lossy_link");
+}
+#endif /* RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO */
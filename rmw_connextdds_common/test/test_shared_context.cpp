@@ -0,0 +1,121 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test_utils.hpp"
+
+class TestSharedContext : public ::testing::Test
+{
+protected:
+  ScopedEnv participant_scope{RMW_CONNEXT_ENV_PARTICIPANT_SCOPE, "process"};
+};
+
+TEST_F(TestSharedContext, contexts_share_implementation)
+{
+  TestContext ctx_a;
+  TestContext ctx_b;
+  ASSERT_EQ(ctx_a.context.impl, ctx_b.context.impl);
+
+  rmw_node_t * const node_a = ctx_a.create_node("test_shared_a");
+  ASSERT_NE(nullptr, node_a) << rmw_get_error_string().str;
+  rmw_node_t * const node_b = ctx_b.create_node("test_shared_b");
+  ASSERT_NE(nullptr, node_b) << rmw_get_error_string().str;
+
+  rmw_context_impl_t * const impl = ctx_a.context.impl;
+  EXPECT_EQ(2u, impl->node_count);
+  EXPECT_NE(nullptr, impl->participant);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node_a));
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node_b));
+}
+
+TEST_F(TestSharedContext, shutdown_is_tracked_per_context)
+{
+  TestContext ctx_a;
+  TestContext ctx_b;
+  rmw_context_impl_t * const impl = ctx_a.context.impl;
+  ASSERT_EQ(impl, ctx_b.context.impl);
+
+  ctx_a.shutdown();
+  EXPECT_TRUE(impl->is_context_shutdown(&ctx_a.context));
+  EXPECT_FALSE(impl->is_context_shutdown(&ctx_b.context));
+  EXPECT_FALSE(impl->is_shutdown);
+
+  // The shut down context can no longer create nodes, the other one can.
+  EXPECT_EQ(nullptr, ctx_a.create_node("test_shared_a"));
+  rmw_reset_error();
+  rmw_node_t * const node_b = ctx_b.create_node("test_shared_b");
+  ASSERT_NE(nullptr, node_b) << rmw_get_error_string().str;
+
+  // A context initialized now attaches to the running implementation, and
+  // it is not affected by the shutdown of ctx_a.
+  {
+    TestContext ctx_c;
+    EXPECT_EQ(impl, ctx_c.context.impl);
+    EXPECT_FALSE(impl->is_context_shutdown(&ctx_c.context));
+    EXPECT_FALSE(impl->is_shutdown);
+  }
+
+  ctx_b.shutdown();
+  EXPECT_TRUE(impl->is_shutdown);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node_b));
+}
+
+TEST_F(TestSharedContext, shut_down_implementation_is_not_shared)
+{
+  TestContext ctx_a;
+  rmw_context_impl_t * const impl_a = ctx_a.context.impl;
+
+  // ctx_a is shut down but not finalized yet: a new context must not attach
+  // to the implementation, which is about to be torn down.
+  ctx_a.shutdown();
+  ASSERT_TRUE(impl_a->is_shutdown);
+
+  TestContext ctx_b;
+  rmw_context_impl_t * const impl_b = ctx_b.context.impl;
+  EXPECT_NE(impl_a, impl_b);
+  EXPECT_FALSE(impl_b->is_shutdown);
+  EXPECT_FALSE(impl_b->is_context_shutdown(&ctx_b.context));
+
+  rmw_node_t * const node_b = ctx_b.create_node("test_shared_b");
+  ASSERT_NE(nullptr, node_b) << rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node_b));
+
+  // Finalizing ctx_a doesn't affect the implementation used by ctx_b
+  ctx_a.fini();
+  TestContext ctx_c;
+  EXPECT_EQ(impl_b, ctx_c.context.impl);
+}
+
+TEST_F(TestSharedContext, detached_context_is_replaced_as_base)
+{
+  TestContext ctx_a;
+  TestContext ctx_b;
+  rmw_context_impl_t * const impl = ctx_a.context.impl;
+  ASSERT_EQ(impl, ctx_b.context.impl);
+  EXPECT_EQ(&ctx_a.context, impl->base.load());
+
+  rmw_node_t * const node_b = ctx_b.create_node("test_shared_b");
+  ASSERT_NE(nullptr, node_b) << rmw_get_error_string().str;
+
+  // ctx_a detaches from the implementation, which keeps running for ctx_b
+  ctx_a.fini();
+  EXPECT_EQ(&ctx_b.context, impl->base.load());
+  EXPECT_FALSE(impl->is_shutdown);
+  EXPECT_NE(nullptr, impl->participant);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(node_b));
+}
@@ -0,0 +1,225 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "rmw/message_sequence.h"
+
+#include "rmw_connextdds/rmw_impl.hpp"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "test_utils.hpp"
+
+#if RMW_CONNEXT_HAVE_TAKE_SEQ
+/* A subscription holds up to RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX loans on
+   its reader, in a ring which is consumed in the order in which the loans
+   were taken. Samples must be taken in the order in which they were
+   published, whether they are deserialized while they are taken, or once a
+   whole batch (possibly spanning several loans) was taken. */
+class TestSubscriberLoans : public ::testing::Test
+{
+protected:
+  explicit TestSubscriberLoans(const char * const deserialize_threads = "")
+  : deserialize_threads(RMW_CONNEXT_ENV_DESERIALIZE_THREADS, deserialize_threads)
+  {}
+
+  void
+  SetUp() override
+  {
+    this->node = this->test_ctx.create_node("test_subscriber_loans");
+    ASSERT_NE(nullptr, this->node) << rmw_get_error_string().str;
+
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = 100;
+
+    const rosidl_message_type_support_t * const type_support =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    this->pub =
+      test_create_publisher(
+      this->node, type_support, "/test_subscriber_loans", &qos);
+    ASSERT_NE(nullptr, this->pub) << rmw_get_error_string().str;
+    this->sub =
+      test_create_subscription(
+      this->node, type_support, "/test_subscriber_loans", &qos);
+    ASSERT_NE(nullptr, this->sub) << rmw_get_error_string().str;
+
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_message_sequence_init(&this->msg_seq, batch_max, &allocator));
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_message_info_sequence_init(&this->info_seq, batch_max, &allocator));
+    for (size_t i = 0; i < batch_max; i++) {
+      ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&this->msgs[i]));
+      this->msg_seq.data[i] = &this->msgs[i];
+    }
+  }
+
+  void
+  TearDown() override
+  {
+    for (size_t i = 0; i < batch_max; i++) {
+      test_msgs__msg__BasicTypes__fini(&this->msgs[i]);
+    }
+    rmw_message_info_sequence_fini(&this->info_seq);
+    rmw_message_sequence_fini(&this->msg_seq);
+    if (nullptr != this->sub) {
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_destroy_subscription(this->node, this->sub));
+    }
+    if (nullptr != this->pub) {
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_destroy_publisher(this->node, this->pub));
+    }
+    if (nullptr != this->node) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node));
+    }
+  }
+
+  void
+  publish(const size_t count)
+  {
+    for (size_t i = 0; i < count; i++) {
+      this->msgs[0].int64_value = this->published;
+      ASSERT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_publish(this->pub, &this->msgs[0], nullptr)) <<
+        rmw_get_error_string().str;
+      this->published += 1;
+    }
+  }
+
+  // Take up to `count` samples at once (with rmw_take_sequence() if
+  // `sequence` is true), and check that they follow the ones already taken.
+  size_t
+  take(const size_t count, const bool sequence)
+  {
+    size_t taken = 0;
+    if (sequence) {
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_take_sequence(
+          this->sub, count, &this->msg_seq, &this->info_seq, &taken,
+          nullptr)) << rmw_get_error_string().str;
+    } else {
+      bool taken_one = false;
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_take(this->sub, &this->msgs[0], &taken_one, nullptr)) <<
+        rmw_get_error_string().str;
+      taken = taken_one ? 1 : 0;
+    }
+    for (size_t i = 0; i < taken; i++) {
+      EXPECT_EQ(this->received, this->msgs[i].int64_value);
+      this->received += 1;
+    }
+    return taken;
+  }
+
+  // Take `count` samples (in batches of at most `batch`), waiting for them
+  // to be received.
+  void
+  take_all(const size_t count, const size_t batch, const bool sequence)
+  {
+    const int64_t expected = this->received + static_cast<int64_t>(count);
+    const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (this->received < expected &&
+      std::chrono::steady_clock::now() < deadline)
+    {
+      const int64_t left = expected - this->received;
+      if (0 == this->take(std::min(batch, static_cast<size_t>(left)), sequence)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    EXPECT_EQ(expected, this->received);
+  }
+
+  bool
+  has_data()
+  {
+    return static_cast<RMW_Connext_Subscriber *>(this->sub->data)->has_data();
+  }
+
+  void
+  check_loans()
+  {
+    // Go around the ring of loans a few times: each round leaves a loan
+    // partially consumed, and then takes the rest of its samples together
+    // with those of the next loan.
+    for (size_t round = 0; round < 3 * RMW_CONNEXT_LIMIT_OUTSTANDING_READS_MAX; round++) {
+      this->publish(4);
+      this->take_all(1, 1, false);
+      this->publish(4);
+      this->take_all(7, batch_max, true);
+    }
+
+    // Samples are also taken one by one across loans.
+    this->publish(4);
+    this->take_all(2, 2, true);
+    this->publish(4);
+    this->take_all(6, 1, false);
+
+    EXPECT_FALSE(this->has_data());
+    EXPECT_EQ(0u, this->take(batch_max, true));
+    EXPECT_EQ(this->published, this->received);
+  }
+
+  static const size_t batch_max = 16;
+
+  ScopedEnv deserialize_threads;
+  TestContext test_ctx;
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  test_msgs__msg__BasicTypes msgs[batch_max];
+  rmw_message_sequence_t msg_seq{rmw_get_zero_initialized_message_sequence()};
+  rmw_message_info_sequence_t info_seq{
+    rmw_get_zero_initialized_message_info_sequence()};
+  int64_t published{0};
+  int64_t received{0};
+};
+
+/* Samples of a batch are deserialized while they are taken. */
+TEST_F(TestSubscriberLoans, samples_are_taken_in_order)
+{
+  this->check_loans();
+}
+
+/* Samples of a batch are deserialized by a worker pool once the batch is
+   complete, while the loans they reference are retained. */
+class TestSubscriberLoansParallel : public TestSubscriberLoans
+{
+protected:
+  TestSubscriberLoansParallel()
+  : TestSubscriberLoans("2")
+  {}
+};
+
+TEST_F(TestSubscriberLoansParallel, samples_are_taken_in_order)
+{
+  this->check_loans();
+}
+#endif /* RMW_CONNEXT_HAVE_TAKE_SEQ */
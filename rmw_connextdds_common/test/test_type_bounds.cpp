@@ -0,0 +1,98 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include "rmw_connextdds/rmw_impl.hpp"
+
+#include "rosidl_runtime_c/string_functions.h"
+
+#include "test_msgs/msg/strings.h"
+
+#include "test_utils.hpp"
+
+class TestTypeBounds : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    this->node = this->test_ctx.create_node("test_type_bounds");
+    ASSERT_NE(nullptr, this->node) << rmw_get_error_string().str;
+    this->pub =
+      test_create_publisher(
+      this->node,
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings),
+      "/test_type_bounds");
+    ASSERT_NE(nullptr, this->pub) << rmw_get_error_string().str;
+    ASSERT_TRUE(test_msgs__msg__Strings__init(&this->msg));
+  }
+
+  void
+  TearDown() override
+  {
+    test_msgs__msg__Strings__fini(&this->msg);
+    if (nullptr != this->pub) {
+      EXPECT_EQ(
+        RMW_RET_OK, rmw_api_connextdds_destroy_publisher(this->node, this->pub));
+    }
+    if (nullptr != this->node) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node));
+    }
+  }
+
+  rmw_ret_t
+  publish_string(const size_t len)
+  {
+    const std::string value(len, 'x');
+    EXPECT_TRUE(
+      rosidl_runtime_c__String__assign(&this->msg.string_value, value.c_str()));
+    return rmw_api_connextdds_publish(this->pub, &this->msg, nullptr);
+  }
+
+  // The entry's pattern contains "::", like the DDS names of types.
+  ScopedEnv type_bounds{
+    RMW_CONNEXT_ENV_TYPE_BOUNDS,
+    "test_msgs::msg::dds_::Strings_: max_string=32"};
+  TestContext test_ctx;
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  test_msgs__msg__Strings msg;
+};
+
+TEST_F(TestTypeBounds, bounded_type_rejects_larger_samples)
+{
+  auto pub_impl = static_cast<RMW_Connext_Publisher *>(this->pub->data);
+  EXPECT_FALSE(pub_impl->message_type_support()->unbounded());
+
+  EXPECT_EQ(RMW_RET_OK, this->publish_string(32)) <<
+    rmw_get_error_string().str;
+
+  // Each string is checked against the declared bounds, even if the sample
+  // would still fit in the buffer sized for them.
+  EXPECT_EQ(RMW_RET_ERROR, this->publish_string(33));
+  EXPECT_NE(
+    nullptr,
+    strstr(
+      rmw_get_error_string().str,
+      "member string_value exceeds the bounds declared"));
+  rmw_reset_error();
+
+  // The publisher is still usable after a sample was rejected
+  EXPECT_EQ(RMW_RET_OK, this->publish_string(16)) <<
+    rmw_get_error_string().str;
+}
@@ -0,0 +1,226 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "rmw_connextdds/rmw_impl.hpp"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/strings.h"
+
+#include "test_utils.hpp"
+
+#if RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT
+/* The hash only depends on the structure of a type, so the C and C++ type
+   supports of a message produce the same hash, and different messages
+   produce different ones. */
+TEST(TestTypeHash, compute_type_hash)
+{
+  const rosidl_message_type_support_t * const ts_c =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const rosidl_message_type_support_t * const ts_cpp =
+    rosidl_typesupport_cpp::get_message_type_support_handle<
+    test_msgs::msg::BasicTypes>();
+
+  const uint64_t hash = RMW_Connext_MessageTypeSupport::compute_type_hash(ts_c);
+  ASSERT_NE(0u, hash);
+  EXPECT_EQ(hash, RMW_Connext_MessageTypeSupport::compute_type_hash(ts_cpp));
+  EXPECT_NE(
+    hash,
+    RMW_Connext_MessageTypeSupport::compute_type_hash(
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings)));
+
+  // Hashes are cached by introspection members, which may also be passed
+  // directly (e.g. for the request and reply types of a service).
+  EXPECT_EQ(hash, RMW_Connext_MessageTypeSupport::compute_type_hash(ts_c));
+  bool cpp_version = false;
+  const rosidl_message_type_support_t * const ts_intro =
+    RMW_Connext_MessageTypeSupport::get_type_support_intro(ts_c, cpp_version);
+  ASSERT_NE(nullptr, ts_intro);
+  EXPECT_EQ(
+    hash,
+    RMW_Connext_MessageTypeSupport::compute_type_hash(
+      nullptr, ts_intro->data, cpp_version));
+}
+#endif /* RMW_CONNEXT_HAVE_INTRO_TYPE_SUPPORT */
+
+#if RMW_CONNEXT_TYPE_HASH && RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO
+static const char * const topic_name = "/test_type_hash";
+
+static bool
+wait_for(const std::function<bool()> & condition)
+{
+  for (int i = 0; i < 1000; i++) {
+    if (condition()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+/* Make a publisher advertise a hash which doesn't match its type, as if it
+   belonged to an application built with a different version of it. */
+static void
+advertise_other_type_hash(rmw_publisher_t * const pub)
+{
+  static const char user_data[] = "typehash=0000000000000001;";
+  const DDS_Long user_data_len = static_cast<DDS_Long>(strlen(user_data));
+
+  auto pub_impl = static_cast<RMW_Connext_Publisher *>(pub->data);
+  DDS_DataWriterQos dw_qos = DDS_DataWriterQos_INITIALIZER;
+  ASSERT_EQ(
+    DDS_RETCODE_OK, DDS_DataWriter_get_qos(pub_impl->writer(), &dw_qos));
+  ASSERT_TRUE(
+    DDS_OctetSeq_ensure_length(
+      &dw_qos.user_data.value, user_data_len, user_data_len));
+  memcpy(
+    DDS_OctetSeq_get_contiguous_buffer(&dw_qos.user_data.value),
+    user_data, user_data_len);
+  EXPECT_EQ(
+    DDS_RETCODE_OK, DDS_DataWriter_set_qos(pub_impl->writer(), &dw_qos));
+  DDS_DataWriterQos_finalize(&dw_qos);
+}
+
+static size_t
+matched_publishers(const rmw_subscription_t * const sub)
+{
+  size_t count = 0;
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_api_connextdds_subscription_count_matched_publishers(sub, &count));
+  return count;
+}
+
+static size_t
+publishers(const rmw_node_t * const node)
+{
+  size_t count = 0;
+  EXPECT_EQ(
+    RMW_RET_OK, rmw_api_connextdds_count_publishers(node, topic_name, &count));
+  return count;
+}
+
+static uint64_t
+incompatible_types(const rmw_node_t * const node)
+{
+  rmw_connextdds_incompatible_type_status_t status{0, 0};
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_api_connextdds_node_get_incompatible_type_status(node, &status));
+  return status.total_count;
+}
+
+class TestTypeHashMatching : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    this->node_remote = this->ctx_remote.create_node("test_type_hash_remote");
+    ASSERT_NE(nullptr, this->node_remote) << rmw_get_error_string().str;
+    this->pub =
+      test_create_publisher(
+      this->node_remote,
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes),
+      topic_name);
+    ASSERT_NE(nullptr, this->pub) << rmw_get_error_string().str;
+  }
+
+  void
+  TearDown() override
+  {
+    if (nullptr != this->sub) {
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_destroy_subscription(this->node_local, this->sub));
+    }
+    if (nullptr != this->node_local) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node_local));
+    }
+    if (nullptr != this->pub) {
+      EXPECT_EQ(
+        RMW_RET_OK,
+        rmw_api_connextdds_destroy_publisher(this->node_remote, this->pub));
+    }
+    if (nullptr != this->node_remote) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_destroy_node(this->node_remote));
+    }
+  }
+
+  void
+  create_local_subscription()
+  {
+    this->sub =
+      test_create_subscription(
+      this->node_local,
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes),
+      topic_name);
+    ASSERT_NE(nullptr, this->sub) << rmw_get_error_string().str;
+  }
+
+  // Each context has its own participant, so the publisher is a remote
+  // endpoint for the local participant.
+  TestContext ctx_remote;
+  rmw_node_t * node_remote{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  TestContext ctx_local;
+  rmw_node_t * node_local{nullptr};
+  rmw_subscription_t * sub{nullptr};
+};
+
+/* A matched endpoint which starts advertising a different hash for a type
+   registered locally is ignored. */
+TEST_F(TestTypeHashMatching, ignores_endpoint_with_different_hash)
+{
+  this->node_local = this->ctx_local.create_node("test_type_hash_local");
+  ASSERT_NE(nullptr, this->node_local) << rmw_get_error_string().str;
+  this->create_local_subscription();
+  ASSERT_TRUE(wait_for([this]() {return 1u == matched_publishers(this->sub);}));
+  EXPECT_EQ(0u, incompatible_types(this->node_local));
+
+  advertise_other_type_hash(this->pub);
+
+  EXPECT_TRUE(wait_for([this]() {return 0u == matched_publishers(this->sub);}));
+  EXPECT_EQ(1u, incompatible_types(this->node_local));
+}
+
+/* An endpoint discovered before the type was registered locally is ignored
+   once the type is registered, and removed from the graph. */
+TEST_F(TestTypeHashMatching, ignores_endpoint_discovered_before_type)
+{
+  advertise_other_type_hash(this->pub);
+
+  this->node_local = this->ctx_local.create_node("test_type_hash_local");
+  ASSERT_NE(nullptr, this->node_local) << rmw_get_error_string().str;
+  ASSERT_TRUE(wait_for([this]() {return 1u == publishers(this->node_local);}));
+  EXPECT_EQ(0u, incompatible_types(this->node_local));
+
+  this->create_local_subscription();
+
+  EXPECT_EQ(1u, incompatible_types(this->node_local));
+  EXPECT_EQ(0u, publishers(this->node_local));
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  EXPECT_EQ(0u, matched_publishers(this->sub));
+}
+#endif /* RMW_CONNEXT_TYPE_HASH && \
+          RMW_CONNEXT_DDS_API == RMW_CONNEXT_DDS_API_PRO */
@@ -0,0 +1,139 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/msg/strings.h"
+
+#include "rmw_connextdds/typecode.hpp"
+
+#include "test_utils.hpp"
+
+static const char * const basic_types_name = "test_msgs::msg::dds_::BasicTypes_";
+static const char * const strings_name = "test_msgs::msg::dds_::Strings_";
+
+static DDS_TypeCode * precomputed_basic_types = nullptr;
+static DDS_TypeCode * precomputed_strings = nullptr;
+
+static DDS_TypeCode *
+provide_basic_types()
+{
+  return precomputed_basic_types;
+}
+
+static DDS_TypeCode *
+provide_strings()
+{
+  return precomputed_strings;
+}
+
+static bool
+typecodes_equal(const DDS_TypeCode * const a, const DDS_TypeCode * const b)
+{
+  DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+  return DDS_BOOLEAN_TRUE == DDS_TypeCode_equal(a, b, &ex) &&
+         DDS_NO_EXCEPTION_CODE == ex;
+}
+
+/* A precomputed type code registered for a different version of the type
+   (i.e. with a different hash) is ignored. */
+TEST(TestTypeCode, ignores_precomputed_typecode_of_changed_type)
+{
+  const rosidl_message_type_support_t * const ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const uint64_t type_hash =
+    RMW_Connext_MessageTypeSupport::compute_type_hash(ts);
+  ASSERT_NE(0u, type_hash);
+
+  DDS_TypeCode * const expected =
+    rmw_connextdds_create_typecode(ts, basic_types_name);
+  ASSERT_NE(nullptr, expected) << rmw_get_error_string().str;
+  precomputed_basic_types =
+    rmw_connextdds_create_typecode(
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings), basic_types_name);
+  ASSERT_NE(nullptr, precomputed_basic_types) << rmw_get_error_string().str;
+  ASSERT_FALSE(typecodes_equal(expected, precomputed_basic_types));
+
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_connextdds_register_typecode(
+      basic_types_name, provide_basic_types, type_hash + 1));
+
+  DDS_TypeCode * const tc = rmw_connextdds_create_typecode(ts, basic_types_name);
+  ASSERT_NE(nullptr, tc) << rmw_get_error_string().str;
+  EXPECT_TRUE(typecodes_equal(expected, tc));
+
+  rmw_connextdds_delete_typecode(tc);
+  rmw_connextdds_delete_typecode(expected);
+}
+
+/* Precomputed type codes are checked at build time, so at runtime they are
+   used as long as the type's hash matches, without generating a type code
+   to compare them with (here, the members of BasicTypes under the name of
+   Strings are used as they are). */
+TEST(TestTypeCode, uses_precomputed_typecode_of_same_type)
+{
+  const rosidl_message_type_support_t * const ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings);
+
+  precomputed_strings =
+    rmw_connextdds_create_typecode(
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes), strings_name);
+  ASSERT_NE(nullptr, precomputed_strings) << rmw_get_error_string().str;
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_connextdds_register_typecode(
+      strings_name, provide_strings,
+      RMW_Connext_MessageTypeSupport::compute_type_hash(ts)));
+
+  for (size_t i = 0; i < 2; i++) {
+    DDS_TypeCode * const tc = rmw_connextdds_create_typecode(ts, strings_name);
+    ASSERT_NE(nullptr, tc) << rmw_get_error_string().str;
+    EXPECT_TRUE(typecodes_equal(precomputed_strings, tc));
+    rmw_connextdds_delete_typecode(tc);
+  }
+}
+
+/* The build time check rejects a type code which doesn't match the type,
+   and returns the hash to register with one that does. */
+TEST(TestTypeCode, check_typecode)
+{
+  const rosidl_message_type_support_t * const ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * const type_name = "test_msgs::msg::dds_::BasicTypes_";
+
+  DDS_TypeCode * const matching =
+    rmw_connextdds_create_typecode(ts, type_name);
+  ASSERT_NE(nullptr, matching) << rmw_get_error_string().str;
+  DDS_TypeCode * const mismatching =
+    rmw_connextdds_create_typecode(
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings), type_name);
+  ASSERT_NE(nullptr, mismatching) << rmw_get_error_string().str;
+
+  uint64_t type_hash = 0;
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_connextdds_check_typecode(ts, type_name, matching, &type_hash)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(RMW_Connext_MessageTypeSupport::compute_type_hash(ts), type_hash);
+
+  EXPECT_EQ(
+    RMW_RET_ERROR,
+    rmw_connextdds_check_typecode(ts, type_name, mismatching, &type_hash));
+  rmw_reset_error();
+
+  rmw_connextdds_delete_typecode(mismatching);
+  rmw_connextdds_delete_typecode(matching);
+}
@@ -0,0 +1,174 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_UTILS_HPP_
+#define TEST_UTILS_HPP_
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "rcutils/env.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/init.h"
+#include "rmw/init_options.h"
+#include "rmw/qos_profiles.h"
+
+#include "rmw_connextdds/rmw_api_impl.hpp"
+
+/* Set an environment variable for the duration of a test. */
+class ScopedEnv
+{
+public:
+  ScopedEnv(const char * const name, const char * const value)
+  : name(name)
+  {
+    EXPECT_TRUE(rcutils_set_env(name, value));
+  }
+
+  ~ScopedEnv()
+  {
+    EXPECT_TRUE(rcutils_set_env(this->name.c_str(), nullptr));
+  }
+
+private:
+  std::string name;
+};
+
+/* rmw context initialized (and finalized) by the test. */
+class TestContext
+{
+public:
+  TestContext()
+  {
+    this->init();
+  }
+
+  ~TestContext()
+  {
+    this->fini();
+  }
+
+  void
+  init()
+  {
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    this->options = rmw_get_zero_initialized_init_options();
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_init_options_init(&this->options, allocator));
+#if RMW_CONNEXT_HAVE_OPTIONS
+    this->options.enclave = rcutils_strdup("/", allocator);
+#endif /* RMW_CONNEXT_HAVE_OPTIONS */
+    this->context = rmw_get_zero_initialized_context();
+    ASSERT_EQ(
+      RMW_RET_OK,
+      rmw_api_connextdds_init(&this->options, &this->context)) <<
+      rmw_get_error_string().str;
+    this->initialized = true;
+  }
+
+  void
+  shutdown()
+  {
+    if (!this->shut_down) {
+      EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_shutdown(&this->context));
+      this->shut_down = true;
+    }
+  }
+
+  void
+  fini()
+  {
+    if (!this->initialized) {
+      return;
+    }
+    this->shutdown();
+    EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_context_fini(&this->context)) <<
+      rmw_get_error_string().str;
+    EXPECT_EQ(RMW_RET_OK, rmw_api_connextdds_init_options_fini(&this->options));
+    this->initialized = false;
+  }
+
+  rmw_node_t *
+  create_node(const char * const name)
+  {
+    return rmw_api_connextdds_create_node(
+      &this->context, name, "/"
+#if RMW_CONNEXT_RELEASE <= RMW_CONNEXT_RELEASE_DASHING
+      , 0, nullptr
+#elif RMW_CONNEXT_RELEASE <= RMW_CONNEXT_RELEASE_ELOQUENT
+      , 0, nullptr, false
+#elif RMW_CONNEXT_RELEASE <= RMW_CONNEXT_RELEASE_FOXY
+      , 0, false
+#endif /* RMW_CONNEXT_RELEASE */
+    );
+  }
+
+  rmw_init_options_t options;
+  rmw_context_t context;
+
+private:
+  bool initialized{false};
+  bool shut_down{false};
+};
+
+inline
+rmw_publisher_t *
+test_create_publisher(
+  const rmw_node_t * const node,
+  const rosidl_message_type_support_t * const type_support,
+  const char * const topic_name,
+  const rmw_qos_profile_t * const qos = &rmw_qos_profile_default,
+  void * const rmw_specific_payload = nullptr)
+{
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+  pub_options.rmw_specific_publisher_payload = rmw_specific_payload;
+#else
+  (void)rmw_specific_payload;
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  return rmw_api_connextdds_create_publisher(
+    node, type_support, topic_name, qos
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+    , &pub_options
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  );
+}
+
+inline
+rmw_subscription_t *
+test_create_subscription(
+  const rmw_node_t * const node,
+  const rosidl_message_type_support_t * const type_support,
+  const char * const topic_name,
+  const rmw_qos_profile_t * const qos = &rmw_qos_profile_default)
+{
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+  const rmw_subscription_options_t sub_options =
+    rmw_get_default_subscription_options();
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  return rmw_api_connextdds_create_subscription(
+    node, type_support, topic_name, qos,
+#if RMW_CONNEXT_HAVE_OPTIONS_PUBSUB
+    &sub_options
+#else
+    false
+#endif /* RMW_CONNEXT_HAVE_OPTIONS_PUBSUB */
+  );
+}
+
+#endif  // TEST_UTILS_HPP_
@@ -0,0 +1,111 @@
+// Copyright 2020 Real-Time Innovations, Inc. (RTI)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "rmw_connextdds/worker_pool.hpp"
+
+TEST(TestWorkerPool, runs_every_job_once)
+{
+  RMW_Connext_WorkerPool pool(3);
+  ASSERT_EQ(3u, pool.threads_len());
+
+  std::vector<std::atomic<int>> calls(100);
+  for (auto & c : calls) {
+    c.store(0);
+  }
+
+  pool.run(calls.size(), [&calls](const size_t i) {calls[i] += 1;});
+
+  for (size_t i = 0; i < calls.size(); i++) {
+    EXPECT_EQ(1, calls[i].load()) << "job " << i;
+  }
+}
+
+TEST(TestWorkerPool, runs_jobs_on_worker_threads)
+{
+  RMW_Connext_WorkerPool pool(2);
+
+  std::mutex threads_mutex;
+  std::set<std::thread::id> threads;
+  std::atomic<size_t> started(0);
+
+  // Every job waits until all three threads are running one, so the batch
+  // can only complete if both workers took part in it.
+  pool.run(
+    3,
+    [&](const size_t) {
+      {
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        threads.insert(std::this_thread::get_id());
+      }
+      started += 1;
+      while (started.load() < 3) {
+        std::this_thread::yield();
+      }
+    });
+
+  EXPECT_EQ(3u, threads.size());
+  EXPECT_EQ(1u, threads.count(std::this_thread::get_id()));
+}
+
+TEST(TestWorkerPool, is_reused_across_batches)
+{
+  RMW_Connext_WorkerPool pool(2);
+
+  for (size_t batch = 0; batch < 50; batch++) {
+    std::atomic<size_t> sum(0);
+    pool.run(batch, [&sum](const size_t i) {sum += i + 1;});
+    EXPECT_EQ(batch * (batch + 1) / 2, sum.load());
+  }
+}
+
+TEST(TestWorkerPool, serializes_concurrent_batches)
+{
+  RMW_Connext_WorkerPool pool(2);
+
+  std::atomic<size_t> total(0);
+  std::vector<std::thread> callers;
+  for (size_t i = 0; i < 4; i++) {
+    callers.emplace_back(
+      [&pool, &total]() {
+        for (size_t batch = 0; batch < 20; batch++) {
+          std::atomic<size_t> done(0);
+          pool.run(10, [&done](const size_t) {done += 1;});
+          EXPECT_EQ(10u, done.load());
+          total += done.load();
+        }
+      });
+  }
+  for (auto & caller : callers) {
+    caller.join();
+  }
+
+  EXPECT_EQ(4u * 20u * 10u, total.load());
+}
+
+TEST(TestWorkerPool, runs_without_workers)
+{
+  RMW_Connext_WorkerPool pool(0);
+
+  std::atomic<size_t> done(0);
+  pool.run(5, [&done](const size_t) {done += 1;});
+  EXPECT_EQ(5u, done.load());
+}